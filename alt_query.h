@@ -0,0 +1,361 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "dijkstra_engine.h"
+#include "shortest_path.h"
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+
+
+// ALT preprocessing (A*, landmarks, triangle inequality) for repeated queries on a static graph.
+// For every landmark l the distance d(l, v) to every vertex is stored, and
+// |d(l, t) - d(l, v)| <= d(v, t) gives an A* lower bound towards the target t.
+// Landmarks are picked by farthest selection: each new landmark maximizes the distance to the chosen ones.
+class LandmarkIndex {
+private:
+
+    int vertexCount = 0;
+    std::vector<int> landmarks;
+    std::vector<int> tables;    // vertex-major: tables[v * landmarkCount + l] = d(l, v)
+
+public:
+
+    LandmarkIndex() = default;
+
+    LandmarkIndex(const CsrGraph<int>& graph, int landmarkCount)
+    {
+        const int infinity = std::numeric_limits<int>::max();
+
+        vertexCount = graph.GetVertexCount();
+        landmarkCount = std::max(0, std::min(landmarkCount, vertexCount));
+
+        if (landmarkCount == 0)
+            return;
+
+        DijkstraEngine<BinaryHeap> engine;
+        std::vector<std::vector<int>> columns;
+        std::vector<int> nearest(vertexCount, infinity);
+
+        // the first landmark is the vertex farthest from vertex 0
+        const std::vector<int>& start = engine.Run(graph, 0);
+        int next = 0;
+
+        for (int v = 0; v < vertexCount; v++)
+            if (start[v] != infinity && start[v] > start[next])
+                next = v;
+
+        while ((int)landmarks.size() < landmarkCount)
+        {
+            landmarks.push_back(next);
+            columns.push_back(engine.Run(graph, next));
+
+            const std::vector<int>& distances = columns.back();
+
+            for (int v = 0; v < vertexCount; v++)
+                nearest[v] = std::min(nearest[v], distances[v]);
+
+            // unreached vertices count as infinitely far, so other components get landmarks too
+            next = -1;
+
+            for (int v = 0; v < vertexCount; v++)
+                if (nearest[v] > 0 && (next == -1 || nearest[v] > nearest[next]))
+                    next = v;
+
+            if (next == -1)
+                break;
+        }
+
+        int count = (int)landmarks.size();
+        tables.resize((size_t)vertexCount * count);
+
+        for (int v = 0; v < vertexCount; v++)
+            for (int l = 0; l < count; l++)
+                tables[(size_t)v * count + l] = columns[l][v];
+    }
+
+    int GetLandmarkCount() const
+    {
+        return (int)landmarks.size();
+    }
+
+    int GetLandmark(int index) const
+    {
+        return landmarks[index];
+    }
+
+    int GetVertexCount() const
+    {
+        return vertexCount;
+    }
+
+    // Lower bound on d(vertex, target); infinity means the target cannot be reached from the vertex.
+    int LowerBound(int vertex, int target) const
+    {
+        const int infinity = std::numeric_limits<int>::max();
+        int count = (int)landmarks.size();
+        const int* from = tables.data() + (size_t)vertex * count;
+        const int* to = tables.data() + (size_t)target * count;
+        int bound = 0;
+
+        for (int l = 0; l < count; l++)
+        {
+            if (from[l] == infinity || to[l] == infinity)
+            {
+                if (from[l] != to[l])
+                    return infinity;
+
+                continue;
+            }
+
+            int difference = from[l] > to[l] ? from[l] - to[l] : to[l] - from[l];
+
+            if (difference > bound)
+                bound = difference;
+        }
+
+        return bound;
+    }
+
+    // Saves the graph together with the landmark tables.
+    void Save(const std::string& filename, const CsrGraph<int>& graph) const
+    {
+        std::ofstream file(filename);
+
+        if (!file)
+        {
+            std::cerr << "Error opening file for writing\n";
+            return;
+        }
+
+        int count = (int)landmarks.size();
+        int vertexCount = graph.GetVertexCount();
+
+        // a self-loop is stored once, so the entry count is not always twice the edge count
+        int entryCount = vertexCount == 0 ? 0 : graph.NeighborsEnd(vertexCount - 1);
+
+        file << vertexCount << " " << entryCount << " " << count << "\n";
+
+        for (int v = 0; v < graph.GetVertexCount(); v++)
+            file << graph.GetVertex(v) << " " << graph.GetDegree(v) << "\n";
+
+        for (int v = 0; v < graph.GetVertexCount(); v++)
+            for (int p = graph.NeighborsBegin(v); p < graph.NeighborsEnd(v); p++)
+                file << graph.GetNeighbor(p) << " " << graph.GetWeight(p) << "\n";
+
+        for (int l = 0; l < count; l++)
+            file << landmarks[l] << (l + 1 < count ? " " : "\n");
+
+        for (size_t i = 0; i < tables.size(); i++)
+            file << tables[i] << ((i + 1) % count == 0 ? "\n" : " ");
+    }
+
+    // Loads a graph and its landmark tables written by Save.
+    static bool Load(const std::string& filename, CsrGraph<int>& graph, LandmarkIndex& index)
+    {
+        std::ifstream file(filename);
+
+        if (!file)
+        {
+            std::cerr << "Error opening file for reading\n";
+            return false;
+        }
+
+        int vertexCount;
+        int entryCount;
+        int count;
+
+        if (!(file >> vertexCount >> entryCount >> count) || vertexCount < 0 || entryCount < 0 || count < 0)
+            return false;
+
+        std::vector<int> vertexes(vertexCount);
+        std::vector<int> offsets(vertexCount + 1, 0);
+        std::vector<int> neighbors(entryCount);
+        std::vector<int> weights(entryCount);
+
+        if (count > vertexCount)
+            return false;
+
+        // every field is checked as it is read, so a malformed file never yields a graph that queries
+        // would index out of bounds
+        for (int v = 0; v < vertexCount; v++)
+        {
+            int degree;
+
+            if (!(file >> vertexes[v] >> degree) || degree < 0 || degree > entryCount - offsets[v])
+                return false;
+
+            offsets[v + 1] = offsets[v] + degree;
+        }
+
+        if (offsets[vertexCount] != entryCount)
+            return false;
+
+        // a key given twice would leave one of its rows unreachable by GetIndex
+        std::vector<int> sortedVertexes(vertexes);
+        std::sort(sortedVertexes.begin(), sortedVertexes.end());
+
+        if (std::adjacent_find(sortedVertexes.begin(), sortedVertexes.end()) != sortedVertexes.end())
+            return false;
+
+        // negative weights or distances would make the landmark bounds inadmissible
+        for (int p = 0; p < entryCount; p++)
+            if (!(file >> neighbors[p] >> weights[p]) || neighbors[p] < 0 || neighbors[p] >= vertexCount || weights[p] < 0)
+                return false;
+
+        LandmarkIndex loaded;
+        loaded.vertexCount = vertexCount;
+        loaded.landmarks.resize(count);
+        loaded.tables.resize((size_t)vertexCount * count);
+
+        std::vector<char> isLandmark(vertexCount, false);
+
+        for (int l = 0; l < count; l++)
+        {
+            int& landmark = loaded.landmarks[l];
+
+            if (!(file >> landmark) || landmark < 0 || landmark >= vertexCount || isLandmark[landmark])
+                return false;
+
+            isLandmark[landmark] = true;
+        }
+
+        // unreachable entries hold the int maximum, so every valid distance is non-negative
+        for (size_t i = 0; i < loaded.tables.size(); i++)
+            if (!(file >> loaded.tables[i]) || loaded.tables[i] < 0)
+                return false;
+
+        for (int l = 0; l < count; l++)
+            if (loaded.tables[(size_t)loaded.landmarks[l] * count + l] != 0)
+                return false;
+
+        graph = CsrGraph<int>(std::move(vertexes), std::move(offsets), std::move(neighbors), std::move(weights));
+        index = std::move(loaded);
+
+        return true;
+    }
+};
+
+
+// A* point-to-point queries guided by a LandmarkIndex. Scratch buffers are reused between queries.
+template <typename TQueue = BinaryHeap>
+class AltQuery {
+private:
+
+    const CsrGraph<int>& graph;
+    const LandmarkIndex& index;
+    TQueue queue;
+    std::vector<int> distances;
+    std::vector<int> bounds;
+    std::vector<int> parents;
+    std::vector<unsigned> reached;
+    std::vector<unsigned> settled;
+    unsigned stamp = 0;
+    int settledCount = 0;
+    ShortestPathResult<int> result;
+
+public:
+
+    AltQuery(const CsrGraph<int>& graph, const LandmarkIndex& index)
+            : graph(graph),
+              index(index),
+              distances(graph.GetVertexCount()),
+              bounds(graph.GetVertexCount()),
+              parents(graph.GetVertexCount()),
+              reached(graph.GetVertexCount(), 0),
+              settled(graph.GetVertexCount(), 0)
+    {
+        if (index.GetVertexCount() != graph.GetVertexCount())
+            throw std::invalid_argument("Landmark index was built for another graph.");
+    }
+
+    const ShortestPathResult<int>& ShortestPath(int source, int target)
+    {
+        const int infinity = std::numeric_limits<int>::max();
+        int sourceIndex = graph.GetIndex(source);
+        int targetIndex = graph.GetIndex(target);
+
+        if (sourceIndex == -1 || targetIndex == -1)
+            throw std::invalid_argument("Vertex not found in the graph.");
+
+        if (++stamp == 0)
+        {
+            std::fill(reached.begin(), reached.end(), 0);
+            std::fill(settled.begin(), settled.end(), 0);
+            stamp = 1;
+        }
+
+        settledCount = 0;
+        result.distance = infinity;
+        result.path.clear();
+        queue.Reset(graph.GetVertexCount());
+
+        bounds[sourceIndex] = index.LowerBound(sourceIndex, targetIndex);
+
+        if (bounds[sourceIndex] == infinity)
+            return result;
+
+        distances[sourceIndex] = 0;
+        parents[sourceIndex] = -1;
+        reached[sourceIndex] = stamp;
+        queue.Push(sourceIndex, bounds[sourceIndex]);
+
+        while (!queue.IsEmpty())
+        {
+            int vertex;
+            int key;
+            queue.PopMin(vertex, key);
+
+            settled[vertex] = stamp;
+            settledCount++;
+
+            if (vertex == targetIndex)
+                break;
+
+            for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+            {
+                int neighbor = graph.GetNeighbor(p);
+                int candidate = distances[vertex] + graph.GetWeight(p);
+
+                if (settled[neighbor] == stamp)
+                    continue;
+
+                if (reached[neighbor] != stamp)
+                {
+                    bounds[neighbor] = index.LowerBound(neighbor, targetIndex);
+                    reached[neighbor] = stamp;
+                    distances[neighbor] = infinity;
+                }
+
+                if (bounds[neighbor] == infinity || candidate >= distances[neighbor])
+                    continue;
+
+                distances[neighbor] = candidate;
+                parents[neighbor] = vertex;
+                queue.Push(neighbor, candidate + bounds[neighbor]);
+            }
+        }
+
+        if (settled[targetIndex] == stamp)
+        {
+            result.distance = distances[targetIndex];
+
+            for (int vertex = targetIndex; vertex != -1; vertex = parents[vertex])
+                result.path.push_back(graph.GetVertex(vertex));
+
+            std::reverse(result.path.begin(), result.path.end());
+        }
+
+        return result;
+    }
+
+    int GetSettledCount() const
+    {
+        return settledCount;
+    }
+};
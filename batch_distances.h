@@ -0,0 +1,95 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "distance_matrix.h"
+#include "dijkstra_engine.h"
+#include "thread_pool.h"
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+
+
+
+// Distances from many sources at once. Sources are fanned out over a thread pool, every thread reuses
+// its own DijkstraEngine (distances, settled flags, heap), and rows are produced tile by tile so that
+// at most tileRows * V distances are held in memory.
+template <typename TQueue = BinaryHeap>
+class BatchDistanceEngine {
+private:
+
+    ThreadPool pool;
+    std::vector<DijkstraEngine<TQueue>> engines;
+    int tileRows;
+    DistanceMatrix tile;
+
+public:
+
+    explicit BatchDistanceEngine(int threadCount = 0, int tileRows = 256)
+            : pool(threadCount), engines(pool.GetThreadCount()), tileRows(std::max(1, tileRows)) {}
+
+    int GetTileRows() const
+    {
+        return tileRows;
+    }
+
+    // onTile(firstRow, tile) is called for consecutive blocks of sources; the tile is only valid during the call.
+    template <typename TKey>
+    void ForEachTile(const CsrGraph<TKey>& graph, const std::vector<TKey>& sources,
+                     const std::function<void(int, const DistanceMatrix&)>& onTile)
+    {
+        int count = graph.GetVertexCount();
+        std::vector<int> sourceIndexes(sources.size());
+
+        for (int i = 0; i < (int)sources.size(); i++)
+        {
+            sourceIndexes[i] = graph.GetIndex(sources[i]);
+
+            if (sourceIndexes[i] == -1)
+                throw std::invalid_argument("Start vertex not found in the graph.");
+        }
+
+        for (int first = 0; first < (int)sources.size(); first += tileRows)
+        {
+            int rows = std::min(tileRows, (int)sources.size() - first);
+            tile.Reshape(rows, count);
+
+            pool.ParallelFor(rows, 1, [&](int thread, int begin, int end) {
+                for (int row = begin; row < end; row++)
+                {
+                    const std::vector<int>& distances = engines[thread].Run(graph, sourceIndexes[first + row]);
+                    std::copy(distances.begin(), distances.end(), tile.GetRow(row));
+                }
+            });
+
+            onTile(first, tile);
+        }
+    }
+
+    // Whole sources x V matrix in one piece; use ForEachTile when it does not fit in memory.
+    template <typename TKey>
+    DistanceMatrix ComputeDistances(const CsrGraph<TKey>& graph, const std::vector<TKey>& sources)
+    {
+        DistanceMatrix result((int)sources.size(), graph.GetVertexCount());
+
+        ForEachTile(graph, sources, [&](int firstRow, const DistanceMatrix& block) {
+            for (int row = 0; row < block.GetRowCount(); row++)
+                std::copy(block.GetRow(row), block.GetRow(row) + block.GetColumnCount(), result.GetRow(firstRow + row));
+        });
+
+        return result;
+    }
+
+    // All-pairs distances streamed in tiles, rows in the dense vertex order.
+    template <typename TKey>
+    void ForEachAllPairsTile(const CsrGraph<TKey>& graph, const std::function<void(int, const DistanceMatrix&)>& onTile)
+    {
+        std::vector<TKey> sources(graph.GetVertexCount());
+
+        for (int i = 0; i < graph.GetVertexCount(); i++)
+            sources[i] = graph.GetVertex(i);
+
+        ForEachTile(graph, sources, onTile);
+    }
+};
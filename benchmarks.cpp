@@ -0,0 +1,974 @@
+#include "benchmarks.h"
+#include "undirected_graph.h"
+#include "graph_creator.h"
+#include "dynamic_array.h"
+#include "dijkstra_engine.h"
+#include "shortest_path.h"
+#include "alt_query.h"
+#include "contraction_hierarchies.h"
+#include "delta_stepping.h"
+#include "batch_distances.h"
+#include "floyd_warshall.h"
+#include "dense_dijkstra.h"
+#include "dynamic_shortest_paths.h"
+#include "minimum_spanning_tree.h"
+#include "dynamic_minimum_spanning_tree.h"
+#include "graph_coloring.h"
+#include "thread_pool.h"
+#include "hash_table.h"
+#include "flat_hash_table.h"
+#include "concurrent_hash_table.h"
+#include "concurrent_edge_builder.h"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <random>
+#include <vector>
+
+
+
+template <typename TFunction>
+double MeasureMilliseconds(TFunction function)
+{
+    auto start = std::chrono::steady_clock::now();
+    function();
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Makes the compiler assume the value is read, so the work that produced it cannot be optimized away.
+template <typename T>
+void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+template <typename TQueue>
+double MeasureHeapDijkstra(const CsrGraph<int>& graph, int runs)
+{
+    DijkstraEngine<TQueue> engine;
+
+    return MeasureMilliseconds([&]() {
+        for (int i = 0; i < runs; i++)
+            DoNotOptimize(engine.Run(graph, i % graph.GetVertexCount()));
+    }) / runs;
+}
+
+void BenchmarkDijkstraOn(const std::string& name, int vertexCount, int edgeCount, int runs)
+{
+    UndirectedGraph<int> graph = GenerateGraph(vertexCount, edgeCount, 1, 100);
+    CsrGraph<int> csr = graph.Freeze();
+
+    std::cout << name << " graph: V = " << csr.GetVertexCount() << ", E = " << csr.GetEdgeCount() << "\n";
+
+    // the UndirectedGraph entry point, so whatever it does per call besides the scan is timed as well
+    double dense = MeasureMilliseconds([&]() {
+        for (int i = 0; i < runs; i++)
+            DoNotOptimize(graph.DiijkstaAlgorithm(i % vertexCount));
+    }) / runs;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "  array scan O(V^2)   " << dense << " ms\n";
+    std::cout << "  binary heap         " << MeasureHeapDijkstra<BinaryHeap>(csr, runs) << " ms\n";
+    std::cout << "  4-ary heap          " << MeasureHeapDijkstra<QuaternaryHeap>(csr, runs) << " ms\n";
+    std::cout << "  pairing heap        " << MeasureHeapDijkstra<PairingHeap>(csr, runs) << " ms\n";
+}
+
+void BenchmarkDijkstra()
+{
+    std::cout << "Dijkstra, average time per source:\n";
+
+    BenchmarkDijkstraOn("Sparse", 5000, 20000, 20);
+    BenchmarkDijkstraOn("Dense", 400, 400 * 399 / 2 * 9 / 10, 20);
+}
+
+// Road-network-like graph: a side x side grid with random weights.
+UndirectedGraph<int> GenerateGridGraph(int side, int minWeight, int maxWeight)
+{
+    UndirectedGraph<int> graph;
+    std::mt19937 gen(12345);
+    std::uniform_int_distribution<> weightDis(minWeight, maxWeight);
+
+    for (int i = 0; i < side * side; i++)
+        graph.AddVertex(i);
+
+    for (int row = 0; row < side; row++)
+    {
+        for (int column = 0; column < side; column++)
+        {
+            int vertex = row * side + column;
+
+            if (column + 1 < side)
+                graph.AddEdge(vertex, vertex + 1, weightDis(gen));
+
+            if (row + 1 < side)
+                graph.AddEdge(vertex, vertex + side, weightDis(gen));
+        }
+    }
+
+    return graph;
+}
+
+void BenchmarkAltOn(const std::string& name, const CsrGraph<int>& graph, int landmarkCount, int queries)
+{
+    std::mt19937 gen(777);
+    std::uniform_int_distribution<> vertexDis(0, graph.GetVertexCount() - 1);
+    std::vector<std::pair<int, int>> pairs;
+
+    for (int i = 0; i < queries; i++)
+        pairs.push_back({graph.GetVertex(vertexDis(gen)), graph.GetVertex(vertexDis(gen))});
+
+    LandmarkIndex index;
+    double preprocessing = MeasureMilliseconds([&]() {
+        index = LandmarkIndex(graph, landmarkCount);
+    });
+
+    DijkstraEngine<BinaryHeap> engine;
+    ShortestPathQuery<int> bidirectional(graph);
+    AltQuery<> alt(graph, index);
+    long long plainSettled = 0;
+    long long bidirectionalSettled = 0;
+    long long altSettled = 0;
+
+    double plainTime = MeasureMilliseconds([&]() {
+        for (const auto& pair : pairs)
+        {
+            engine.Run(graph, graph.GetIndex(pair.first));
+            plainSettled += engine.GetSettledCount();
+        }
+    }) / queries;
+
+    double bidirectionalTime = MeasureMilliseconds([&]() {
+        for (const auto& pair : pairs)
+        {
+            bidirectional.ShortestPath(pair.first, pair.second);
+            bidirectionalSettled += bidirectional.GetSettledCount();
+        }
+    }) / queries;
+
+    double altTime = MeasureMilliseconds([&]() {
+        for (const auto& pair : pairs)
+        {
+            alt.ShortestPath(pair.first, pair.second);
+            altSettled += alt.GetSettledCount();
+        }
+    }) / queries;
+
+    std::cout << name << " graph: V = " << graph.GetVertexCount() << ", E = " << graph.GetEdgeCount()
+              << ", " << index.GetLandmarkCount() << " landmarks, preprocessing " << preprocessing << " ms\n";
+    std::cout << "  full Dijkstra       " << plainTime << " ms, " << plainSettled / queries << " settled\n";
+    std::cout << "  bidirectional       " << bidirectionalTime << " ms, " << bidirectionalSettled / queries << " settled\n";
+    std::cout << "  ALT                 " << altTime << " ms, " << altSettled / queries << " settled, speedup "
+              << plainTime / altTime << "x, " << (double)plainSettled / std::max(1LL, altSettled) << "x fewer settled\n";
+}
+
+void BenchmarkAlt()
+{
+    std::cout << "Point-to-point queries, average per query:\n";
+
+    BenchmarkAltOn("Grid", GenerateGridGraph(150, 1, 100).Freeze(), 16, 200);
+    BenchmarkAltOn("Random", GenerateGraph(20000, 60000, 1, 100).Freeze(), 16, 200);
+}
+
+void BenchmarkContractionHierarchiesOn(const std::string& name, const CsrGraph<int>& graph, int queries)
+{
+    std::mt19937 gen(4242);
+    std::uniform_int_distribution<> vertexDis(0, graph.GetVertexCount() - 1);
+    std::vector<std::pair<int, int>> pairs;
+
+    for (int i = 0; i < queries; i++)
+        pairs.push_back({graph.GetVertex(vertexDis(gen)), graph.GetVertex(vertexDis(gen))});
+
+    std::cout << name << " graph: V = " << graph.GetVertexCount() << ", E = " << graph.GetEdgeCount() << "\n";
+
+    int reported = 0;
+    ContractionHierarchy<int>* hierarchy = nullptr;
+    double preprocessing = MeasureMilliseconds([&]() {
+        hierarchy = new ContractionHierarchy<int>(graph, 0, [&](int contracted, int total) {
+            while (reported < 4 && contracted * 4 >= total * (reported + 1))
+                std::cout << "  contracted " << 25 * ++reported << "%\n";
+        });
+    });
+
+    ContractionHierarchyQuery<int> query(*hierarchy);
+    ShortestPathQuery<int> bidirectional(graph);
+    long long settled = 0;
+    long long bidirectionalSettled = 0;
+
+    double queryTime = MeasureMilliseconds([&]() {
+        for (const auto& pair : pairs)
+        {
+            query.Distance(pair.first, pair.second);
+            settled += query.GetSettledCount();
+        }
+    }) / queries;
+
+    double bidirectionalTime = MeasureMilliseconds([&]() {
+        for (const auto& pair : pairs)
+        {
+            bidirectional.ShortestPath(pair.first, pair.second);
+            bidirectionalSettled += bidirectional.GetSettledCount();
+        }
+    }) / queries;
+
+    std::cout << "  preprocessing       " << preprocessing << " ms, " << hierarchy->GetShortcutCount() << " shortcuts\n";
+    std::cout << "  bidirectional       " << bidirectionalTime << " ms, " << bidirectionalSettled / queries << " settled\n";
+    std::cout << "  CH query            " << queryTime << " ms, " << settled / queries << " settled\n";
+
+    delete hierarchy;
+}
+
+void BenchmarkContractionHierarchies()
+{
+    std::cout << "Contraction hierarchies, " << ThreadPool::GetDefaultThreadCount() << " threads, average per query:\n";
+
+    BenchmarkContractionHierarchiesOn("Grid", GenerateGridGraph(150, 1, 100).Freeze(), 1000);
+}
+
+// Random multigraph built straight into CSR form, for sizes GenerateGraph cannot reach quickly.
+CsrGraph<int> GenerateLargeCsrGraph(int vertexCount, int edgeCount, int minWeight, int maxWeight)
+{
+    std::mt19937 gen(2024);
+    std::uniform_int_distribution<> vertexDis(0, vertexCount - 1);
+    std::uniform_int_distribution<> weightDis(minWeight, maxWeight);
+    std::vector<int> from(edgeCount);
+    std::vector<int> to(edgeCount);
+    std::vector<int> weight(edgeCount);
+    std::vector<int> offsets(vertexCount + 1, 0);
+
+    for (int i = 0; i < edgeCount; i++)
+    {
+        from[i] = vertexDis(gen);
+        do
+            to[i] = vertexDis(gen);
+        while (to[i] == from[i]);
+        weight[i] = weightDis(gen);
+
+        offsets[from[i] + 1]++;
+        offsets[to[i] + 1]++;
+    }
+
+    for (int v = 0; v < vertexCount; v++)
+        offsets[v + 1] += offsets[v];
+
+    std::vector<int> position(offsets.begin(), offsets.end() - 1);
+    std::vector<int> neighbors(edgeCount * 2);
+    std::vector<int> weights(edgeCount * 2);
+
+    for (int i = 0; i < edgeCount; i++)
+    {
+        neighbors[position[from[i]]] = to[i];
+        weights[position[from[i]]++] = weight[i];
+        neighbors[position[to[i]]] = from[i];
+        weights[position[to[i]]++] = weight[i];
+    }
+
+    std::vector<int> vertexes(vertexCount);
+
+    for (int v = 0; v < vertexCount; v++)
+        vertexes[v] = v;
+
+    return CsrGraph<int>(std::move(vertexes), std::move(offsets), std::move(neighbors), std::move(weights));
+}
+
+// 1, 2, 4, ... and the hardware thread count.
+std::vector<int> ThreadCountsToMeasure()
+{
+    std::vector<int> counts;
+    int maximum = ThreadPool::GetDefaultThreadCount();
+
+    for (int threads = 1; threads < maximum; threads *= 2)
+        counts.push_back(threads);
+
+    counts.push_back(maximum);
+
+    return counts;
+}
+
+void BenchmarkDeltaStepping()
+{
+    CsrGraph<int> graph = GenerateLargeCsrGraph(200000, 1000000, 1, 100);
+    int runs = 5;
+
+    std::cout << "Delta-stepping: V = " << graph.GetVertexCount() << ", E = " << graph.GetEdgeCount()
+              << ", delta = " << DeltaSteppingEngine::ChooseDelta(graph) << ", average per source:\n";
+
+    DijkstraEngine<BinaryHeap> dijkstra;
+    double sequential = MeasureMilliseconds([&]() {
+        for (int i = 0; i < runs; i++)
+            dijkstra.Run(graph, i);
+    }) / runs;
+
+    std::cout << "  binary heap Dijkstra " << sequential << " ms\n";
+
+    for (int threads : ThreadCountsToMeasure())
+    {
+        DeltaSteppingEngine engine(threads);
+        double time = MeasureMilliseconds([&]() {
+            for (int i = 0; i < runs; i++)
+                engine.Run(graph, i);
+        }) / runs;
+
+        std::cout << "  " << threads << " thread(s)          " << time << " ms, speedup " << sequential / time << "x\n";
+    }
+}
+
+void BenchmarkBatchDistances()
+{
+    UndirectedGraph<int> graph = GenerateGraph(5000, 20000, 1, 100);
+    CsrGraph<int> csr = graph.Freeze();
+    std::vector<int> sources;
+
+    for (int i = 0; i < 400; i++)
+        sources.push_back(i);
+
+    int loopRuns = 20;
+    double loop = MeasureMilliseconds([&]() {
+        for (int i = 0; i < loopRuns; i++)
+            graph.DiijkstaAlgorithm(sources[i]);
+    }) / loopRuns;
+
+    std::cout << "Multi-source distances: V = " << csr.GetVertexCount() << ", E = " << csr.GetEdgeCount()
+              << ", " << sources.size() << " sources, average per source:\n";
+    std::cout << "  DiijkstaAlgorithm loop " << loop << " ms\n";
+
+    for (int threads : ThreadCountsToMeasure())
+    {
+        BatchDistanceEngine<> engine(threads, 64);
+        long long checksum = 0;
+        double batch = MeasureMilliseconds([&]() {
+            engine.ForEachTile(csr, sources, [&](int firstRow, const DistanceMatrix& tile) {
+                checksum += tile.Get(0, 0);
+            });
+        }) / sources.size();
+
+        std::cout << "  batch, " << threads << " thread(s)    " << batch << " ms, speedup " << loop / batch << "x\n";
+    }
+}
+
+void BenchmarkFloydWarshallOn(const std::string& name, const CsrGraph<int>& graph)
+{
+    std::cout << name << " graph: V = " << graph.GetVertexCount() << ", E = " << graph.GetEdgeCount() << "\n";
+
+    BatchDistanceEngine<> batch(1);
+    double repeated = MeasureMilliseconds([&]() {
+        batch.ForEachAllPairsTile(graph, [](int firstRow, const DistanceMatrix& tile) {});
+    });
+
+    std::cout << "  repeated Dijkstra, 1 thread  " << repeated << " ms\n";
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2})
+    {
+        if (LimitSimdLevel(level) != level)
+            continue;
+
+        for (int threads : ThreadCountsToMeasure())
+        {
+            FloydWarshallEngine engine(threads);
+            double time = MeasureMilliseconds([&]() {
+                engine.Run(graph, level);
+            });
+
+            std::cout << "  Floyd-Warshall " << GetSimdLevelName(level) << ", " << threads << " thread(s) "
+                      << time << " ms, speedup " << repeated / time << "x\n";
+        }
+    }
+}
+
+void BenchmarkFloydWarshall()
+{
+    std::cout << "All-pairs distances on dense graphs:\n";
+
+    BenchmarkFloydWarshallOn("GenerateGraph", GenerateGraph(300, 300 * 299 / 2 * 9 / 10, 1, 100).Freeze());
+    BenchmarkFloydWarshallOn("Near-complete", GenerateLargeCsrGraph(1000, 1000 * 999 / 2, 1, 100));
+}
+
+void BenchmarkDenseDijkstraOn(const std::string& name, const CsrGraph<int>& graph, int runs)
+{
+    DenseDijkstraEngine dense;
+    DijkstraEngine<QuaternaryHeap> heap;
+    AdaptiveDijkstraEngine adaptive;
+
+    std::cout << name << " graph: V = " << graph.GetVertexCount() << ", E = " << graph.GetEdgeCount() << "\n";
+
+    double scan = MeasureMilliseconds([&]() {
+        for (int i = 0; i < runs; i++)
+            graph.DiijkstaAlgorithm(graph.GetVertex(i));
+    }) / runs;
+
+    std::cout << "  DiijkstaAlgorithm scan " << scan << " ms\n";
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2})
+    {
+        if (LimitSimdLevel(level) != level)
+            continue;
+
+        double time = MeasureMilliseconds([&]() {
+            for (int i = 0; i < runs; i++)
+                dense.Run(graph, i, level);
+        }) / runs;
+
+        std::cout << "  dense " << GetSimdLevelName(level) << "            " << time << " ms\n";
+    }
+
+    double heapTime = MeasureMilliseconds([&]() {
+        for (int i = 0; i < runs; i++)
+            heap.Run(graph, i);
+    }) / runs;
+
+    std::cout << "  4-ary heap            " << heapTime << " ms\n";
+
+    double adaptiveTime = MeasureMilliseconds([&]() {
+        for (int i = 0; i < runs; i++)
+            adaptive.Run(graph, i);
+    }) / runs;
+
+    std::cout << "  auto (" << (adaptive.GetLastMode() == DijkstraMode::Dense ? "dense" : "heap") << ")          "
+              << adaptiveTime << " ms\n";
+}
+
+void BenchmarkDenseDijkstra()
+{
+    std::cout << "Dense vs heap Dijkstra, average per source:\n";
+
+    BenchmarkDenseDijkstraOn("Sparse", GenerateGraph(5000, 20000, 1, 100).Freeze(), 10);
+    BenchmarkDenseDijkstraOn("Medium", GenerateLargeCsrGraph(2000, 100000, 1, 100), 10);
+    BenchmarkDenseDijkstraOn("Dense", GenerateLargeCsrGraph(2000, 1500000, 1, 100), 10);
+}
+
+// Alternates removing a random existing edge and inserting a random new one; the same seed gives the same
+// stream on equal graphs.
+void ApplyRandomMutations(UndirectedGraph<int>& graph, int count, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> vertexDis(0, graph.GetVertexCount() - 1);
+    std::uniform_int_distribution<> weightDis(1, 100);
+
+    for (int i = 0; i < count; i++)
+    {
+        int vertex1 = graph.GetVertex(vertexDis(gen));
+
+        if (i % 2 == 0)
+        {
+            NeighborRange<int> neighbors = graph.Neighbors(vertex1);
+
+            if (!neighbors.IsEmpty())
+                graph.RemoveEdge(vertex1, neighbors[gen() % neighbors.GetLength()].vertex);
+        }
+        else
+        {
+            int vertex2 = graph.GetVertex(vertexDis(gen));
+
+            if (vertex1 != vertex2 && !graph.AreConnected(vertex1, vertex2))
+                graph.AddEdge(vertex1, vertex2, weightDis(gen));
+        }
+    }
+}
+
+// Rebuilds an equal graph from its snapshot.
+UndirectedGraph<int> CopyGraph(const CsrGraph<int>& graph)
+{
+    UndirectedGraph<int> copy(graph.GetVertexCount());
+    std::vector<WeightedEdge> edges;
+
+    for (int i = 0; i < graph.GetVertexCount(); i++)
+        copy.AddVertex(graph.GetVertex(i));
+
+    for (int i = 0; i < graph.GetVertexCount(); i++)
+        for (int p = graph.NeighborsBegin(i); p < graph.NeighborsEnd(i); p++)
+            if (i < graph.GetNeighbor(p))
+                edges.push_back(WeightedEdge(graph.GetVertex(i), graph.GetVertex(graph.GetNeighbor(p)), graph.GetWeight(p)));
+
+    copy.BuildFromEdges(edges);
+
+    return copy;
+}
+
+void BenchmarkDynamicShortestPathsOn(const std::string& name, const UndirectedGraph<int>& original, int mutations)
+{
+    CsrGraph<int> snapshot = original.Freeze();
+    UndirectedGraph<int> plain = CopyGraph(snapshot);
+    UndirectedGraph<int> watched = CopyGraph(snapshot);
+    DynamicShortestPaths<int> paths(watched, watched.GetVertex(0));
+
+    std::cout << name << " graph: V = " << original.GetVertexCount() << ", " << mutations << " mutations\n";
+
+    double mutateOnly = MeasureMilliseconds([&]() { ApplyRandomMutations(plain, mutations, 99); });
+    double mutateAndRepair = MeasureMilliseconds([&]() { ApplyRandomMutations(watched, mutations, 99); });
+
+    DijkstraEngine<QuaternaryHeap> engine;
+    int runs = 5;
+
+    double heap = MeasureMilliseconds([&]() {
+        for (int i = 0; i < runs; i++)
+        {
+            CsrGraph<int> csr = watched.Freeze();
+            engine.Run(csr, csr.GetIndex(watched.GetVertex(0)));
+        }
+    }) / runs;
+
+    double scan = MeasureMilliseconds([&]() { watched.DiijkstaAlgorithm(watched.GetVertex(0)); });
+
+    std::cout << "  repair                      " << std::max(0.0, mutateAndRepair - mutateOnly) / mutations << " ms\n";
+    std::cout << "  Freeze + 4-ary heap rerun   " << heap << " ms\n";
+    std::cout << "  DiijkstaAlgorithm rerun     " << scan << " ms\n";
+}
+
+void BenchmarkDynamicShortestPaths()
+{
+    std::cout << "Dynamic shortest paths, time per edge mutation:\n";
+
+    BenchmarkDynamicShortestPathsOn("Random", GenerateGraph(10000, 40000, 1, 100), 2000);
+    BenchmarkDynamicShortestPathsOn("Grid", GenerateGridGraph(100, 1, 100), 2000);
+}
+
+const char* GetMstAlgorithmName(MstAlgorithm algorithm)
+{
+    if (algorithm == MstAlgorithm::FilterKruskal)
+        return "Filter-Kruskal";
+
+    if (algorithm == MstAlgorithm::Boruvka)
+        return "Boruvka       ";
+
+    return "Kruskal       ";
+}
+
+void BenchmarkMinimumSpanningTreeOn(const std::string& name, const CsrGraph<int>& graph)
+{
+    std::cout << name << " graph: V = " << graph.GetVertexCount() << ", E = " << graph.GetEdgeCount() << "\n";
+
+    for (int threads : ThreadCountsToMeasure())
+    {
+        MinimumSpanningTreeEngine engine(threads);
+
+        for (MstAlgorithm algorithm : {MstAlgorithm::Kruskal, MstAlgorithm::FilterKruskal, MstAlgorithm::Boruvka})
+        {
+            double time = MeasureMilliseconds([&]() { engine.Run(graph, algorithm); });
+
+            std::cout << "  " << GetMstAlgorithmName(algorithm) << " " << threads << " thread(s) " << time << " ms\n";
+        }
+    }
+}
+
+void BenchmarkMinimumSpanningTree()
+{
+    std::cout << "Minimum spanning tree:\n";
+
+    UndirectedGraph<int> graph = GenerateGraph(20000, 200000, 1, 1000);
+    CsrGraph<int> large = GenerateLargeCsrGraph(1000000, 10000000, 1, 1000000);
+
+    double baseline = MeasureMilliseconds([&]() { graph.FindMinimumSpanningTreeKruskal(); });
+    double largeBaseline = MeasureMilliseconds([&]() { large.FindMinimumSpanningTreeKruskal(); });
+
+    std::cout << "Generated graph: FindMinimumSpanningTreeKruskal " << baseline << " ms\n";
+    std::cout << "Large graph: FindMinimumSpanningTreeKruskal " << largeBaseline << " ms\n";
+
+    BenchmarkMinimumSpanningTreeOn("Generated", graph.Freeze());
+    BenchmarkMinimumSpanningTreeOn("Large", large);
+}
+
+// Random new edges, the same stream on equal graphs.
+void AddRandomEdges(UndirectedGraph<int>& graph, int count, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<> vertexDis(0, graph.GetVertexCount() - 1);
+    std::uniform_int_distribution<> weightDis(1, 1000);
+
+    for (int i = 0; i < count; i++)
+    {
+        int vertex1 = graph.GetVertex(vertexDis(gen));
+        int vertex2 = graph.GetVertex(vertexDis(gen));
+
+        if (vertex1 != vertex2 && !graph.AreConnected(vertex1, vertex2))
+            graph.AddEdge(vertex1, vertex2, weightDis(gen));
+    }
+}
+
+void BenchmarkDynamicMinimumSpanningTree()
+{
+    int insertions = 5000;
+    CsrGraph<int> snapshot = GenerateGraph(20000, 60000, 1, 1000).Freeze();
+    UndirectedGraph<int> plain = CopyGraph(snapshot);
+    UndirectedGraph<int> watched = CopyGraph(snapshot);
+    DynamicMinimumSpanningTree<int> mst(watched, 1);
+
+    std::cout << "Incremental MST: V = " << snapshot.GetVertexCount() << ", E = " << snapshot.GetEdgeCount()
+              << ", " << insertions << " insertions, time per insertion:\n";
+
+    double insertOnly = MeasureMilliseconds([&]() { AddRandomEdges(plain, insertions, 5); });
+    double insertAndMaintain = MeasureMilliseconds([&]() { AddRandomEdges(watched, insertions, 5); });
+
+    MinimumSpanningTreeEngine engine(1);
+    int runs = 5;
+
+    double engineRerun = MeasureMilliseconds([&]() {
+        for (int i = 0; i < runs; i++)
+            engine.Run(watched.Freeze());
+    }) / runs;
+
+    double kruskalRerun = MeasureMilliseconds([&]() { watched.FindMinimumSpanningTreeKruskal(); });
+
+    std::cout << "  link-cut tree update                 " << std::max(0.0, insertAndMaintain - insertOnly) / insertions << " ms\n";
+    std::cout << "  Freeze + MinimumSpanningTreeEngine   " << engineRerun << " ms\n";
+    std::cout << "  FindMinimumSpanningTreeKruskal       " << kruskalRerun << " ms\n";
+}
+
+const char* GetColoringOrderName(ColoringOrder order)
+{
+    if (order == ColoringOrder::LargestFirst)
+        return "largest first";
+
+    if (order == ColoringOrder::SmallestLast)
+        return "smallest last";
+
+    if (order == ColoringOrder::Dsatur)
+        return "DSATUR       ";
+
+    return "natural      ";
+}
+
+void BenchmarkColoringOn(const std::string& name, const CsrGraph<int>& graph)
+{
+    ColoringEngine engine;
+
+    std::cout << name << " graph: V = " << graph.GetVertexCount() << ", E = " << graph.GetEdgeCount() << "\n";
+
+    for (ColoringOrder order : {ColoringOrder::Natural, ColoringOrder::LargestFirst, ColoringOrder::SmallestLast, ColoringOrder::Dsatur})
+    {
+        double time = MeasureMilliseconds([&]() { engine.Run(graph, order); });
+
+        std::cout << "  " << GetColoringOrderName(order) << " " << time << " ms, " << engine.GetColorCount() << " colors\n";
+    }
+}
+
+void BenchmarkColoring()
+{
+    std::cout << "Greedy coloring:\n";
+
+    BenchmarkColoringOn("Sparse", GenerateLargeCsrGraph(1000000, 5000000, 1, 100));
+    BenchmarkColoringOn("Dense", GenerateLargeCsrGraph(5000, 2500000, 1, 100));
+}
+
+void BenchmarkParallelColoring()
+{
+    UndirectedGraph<int> generated = GenerateGraph(20000, 200000, 1, 100);
+    CsrGraph<int> graph = GenerateLargeCsrGraph(1000000, 5000000, 1, 100);
+
+    std::cout << "Parallel coloring:\n";
+
+    double generatedTime = MeasureMilliseconds([&]() { generated.ColorGraph(); });
+    std::cout << "  ColorGraph on V = 20000, E = 200000    " << generatedTime << " ms\n";
+
+    ColoringEngine sequential;
+    double sequentialTime = MeasureMilliseconds([&]() { sequential.Run(graph); });
+
+    std::cout << "V = " << graph.GetVertexCount() << ", E = " << graph.GetEdgeCount() << "\n";
+    std::cout << "  sequential first fit " << sequentialTime << " ms, " << sequential.GetColorCount() << " colors\n";
+
+    for (int threads : ThreadCountsToMeasure())
+    {
+        ParallelColoringEngine engine(threads);
+
+        for (ParallelColoringMode mode : {ParallelColoringMode::JonesPlassmann, ParallelColoringMode::Speculative})
+        {
+            double time = MeasureMilliseconds([&]() { engine.Run(graph, mode, 7); });
+
+            std::cout << "  " << (mode == ParallelColoringMode::JonesPlassmann ? "Jones-Plassmann" : "speculative    ")
+                      << " " << threads << " thread(s) " << time << " ms, " << engine.GetColorCount() << " colors, "
+                      << engine.GetRoundCount() << " rounds, " << engine.GetConflictCount() << " conflicts\n";
+        }
+    }
+}
+
+void BenchmarkBulkLoad()
+{
+    int vertexCount = 1000000;
+    int edgeCount = 10000000;
+    int incrementalCount = 1000000;
+    std::mt19937 gen(11);
+    std::uniform_int_distribution<> vertexDis(0, vertexCount - 1);
+    std::uniform_int_distribution<> weightDis(1, 100);
+    std::vector<WeightedEdge> edges(edgeCount);
+
+    for (int i = 0; i < edgeCount; i++)
+        edges[i] = WeightedEdge(vertexDis(gen), vertexDis(gen), weightDis(gen));
+
+    std::cout << "Bulk loading " << edgeCount << " edges over " << vertexCount << " vertices:\n";
+
+    double incrementalTime = MeasureMilliseconds([&]() {
+        UndirectedGraph<int> graph;
+
+        for (int i = 0; i < incrementalCount; i++)
+        {
+            graph.AddVertex(edges[i].vertex1);
+            graph.AddVertex(edges[i].vertex2);
+            graph.AddEdge(edges[i].vertex1, edges[i].vertex2, edges[i].weight);
+        }
+    });
+
+    std::cout << "  AddVertex + AddEdge, first " << incrementalCount << " edges " << incrementalTime << " ms\n";
+
+    for (int threads : ThreadCountsToMeasure())
+    {
+        UndirectedGraph<int> graph;
+        double time = MeasureMilliseconds([&]() { graph.BuildFromEdges(edges, threads); });
+
+        std::cout << "  BuildFromEdges " << threads << " thread(s)   " << time << " ms, "
+                  << graph.Freeze().GetEdgeCount() << " unique edges\n";
+    }
+}
+
+// Insert, hit and miss cost per operation, in nanoseconds. Lookups are capped at 10^7 per size.
+template <typename TTable>
+void MeasureTable(const std::vector<int>& keys, const std::vector<int>& present, const std::vector<int>& missing,
+                  double& insertTime, double& hitTime, double& missTime)
+{
+    TTable table;
+    int lookups = (int)present.size();
+    long long sum = 0;
+
+    insertTime = MeasureMilliseconds([&]() {
+        for (int key : keys)
+            table.Add(key, key);
+    }) * 1e6 / keys.size();
+
+    hitTime = MeasureMilliseconds([&]() {
+        for (int i = 0; i < lookups; i++)
+            sum += table.GetValue(present[i]).value();
+    }) * 1e6 / lookups;
+
+    missTime = MeasureMilliseconds([&]() {
+        for (int i = 0; i < lookups; i++)
+            sum += table.ContainsKey(missing[i]);
+    }) * 1e6 / lookups;
+
+    DoNotOptimize(sum);
+}
+
+void BenchmarkHashTables()
+{
+    // HashTable allocates a node per entry; at 10^8 keys it would need far more memory than the flat table
+    int maxNodeTableKeys = 10000000;
+
+    std::cout << "Hash tables, ns per operation (insert / hit / miss):\n";
+
+    for (int count = 1000; count <= 100000000; count *= 10)
+    {
+        std::vector<int> keys(count);
+        std::vector<int> present(std::min(count, 10000000));
+        std::vector<int> missing(present.size());
+        std::mt19937 gen(count);
+
+        // multiplying by an odd constant is a bijection, so the keys are distinct and scattered
+        for (int i = 0; i < count; i++)
+            keys[i] = (int)((uint32_t)i * 2654435761u);
+
+        // hits in random order, so that neither table profits from insertion order
+        for (int i = 0; i < (int)present.size(); i++)
+        {
+            present[i] = keys[gen() % count];
+            missing[i] = (int)((uint32_t)(count + i) * 2654435761u);
+        }
+
+        double insertTime, hitTime, missTime;
+        MeasureTable<FlatHashTable<int, int>>(keys, present, missing, insertTime, hitTime, missTime);
+
+        std::cout << "  " << std::setw(9) << count << " keys  FlatHashTable " << insertTime << " / " << hitTime
+                  << " / " << missTime;
+
+        if (count <= maxNodeTableKeys)
+        {
+            MeasureTable<HashTable<int, int>>(keys, present, missing, insertTime, hitTime, missTime);
+            std::cout << "   HashTable " << insertTime << " / " << hitTime << " / " << missTime;
+        }
+
+        std::cout << "\n";
+    }
+}
+
+void BenchmarkHashTableRemoval()
+{
+    std::mt19937 gen(17);
+    std::vector<int> keys(1000000);
+
+    for (int& key : keys)
+        key = (int)gen();
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    int count = (int)keys.size();
+    HashTable<int, int> table;
+
+    for (int key : keys)
+        table.Add(key, key);
+
+    ProbeStatistics statistics = table.GetProbeStatistics();
+    int p99 = 0;
+
+    for (int length = 0, seen = 0; length < (int)statistics.histogram.size(); length++)
+    {
+        seen += statistics.histogram[length];
+
+        if (seen < count * 0.99)
+            p99 = length + 1;
+    }
+
+    std::cout << "HashTable removal, " << count << " keys at load " << (double)count / table.GetCapacity() << ":\n";
+    std::cout << "  probe length average " << statistics.averageLength << ", p99 " << p99 << ", max " << statistics.maxLength << "\n";
+
+    std::shuffle(keys.begin(), keys.end(), gen);
+    int resizes = table.GetResizeCount();
+
+    // half of the keys go out and come back, as with RemoveVertex followed by AddVertex
+    double churnTime = MeasureMilliseconds([&]() {
+        for (int i = 0; i < count / 2; i++)
+            table.Remove(keys[i]);
+
+        for (int i = 0; i < count / 2; i++)
+            table.Add(keys[i], i);
+    });
+
+    std::cout << "  remove + re-add half " << churnTime * 1e6 / count << " ns per operation, "
+              << table.GetResizeCount() - resizes << " resizes\n";
+
+    double removeTime = MeasureMilliseconds([&]() {
+        for (int key : keys)
+            table.Remove(key);
+    });
+
+    std::cout << "  remove all           " << removeTime * 1e6 / count << " ns per operation, capacity "
+              << table.GetCapacity() << " afterwards\n";
+}
+
+// Writer threads split an edge list and ingest it into ConcurrentEdgeBuilder, as parser threads would.
+void BenchmarkConcurrentIngestion()
+{
+    int vertexCount = 1000000;
+    int edgeCount = 4000000;
+    std::mt19937 gen(23);
+    std::uniform_int_distribution<> vertexDis(0, vertexCount - 1);
+    std::uniform_int_distribution<> weightDis(1, 100);
+    std::vector<WeightedEdge> edges(edgeCount);
+
+    for (WeightedEdge& edge : edges)
+        edge = WeightedEdge(vertexDis(gen), vertexDis(gen), weightDis(gen));
+
+    std::cout << "Concurrent ingestion of " << edgeCount << " edges over " << vertexCount << " vertices:\n";
+
+    for (int threads : ThreadCountsToMeasure())
+    {
+        ThreadPool pool(threads);
+        ConcurrentHashTable<int, int> table;
+        ConcurrentEdgeBuilder builder;
+
+        double tableTime = MeasureMilliseconds([&]() {
+            pool.ParallelFor(edgeCount, 65536, [&](int thread, int begin, int end) {
+                for (int i = begin; i < end; i++)
+                    table.AddOrUpdate(edges[i].vertex1, [](int& value) { value++; });
+            });
+        });
+
+        double builderTime = MeasureMilliseconds([&]() {
+            pool.ParallelFor(edgeCount, 65536, [&](int thread, int begin, int end) {
+                for (int i = begin; i < end; i++)
+                    builder.AddEdge(edges[i].vertex1, edges[i].vertex2, edges[i].weight);
+            });
+        });
+
+        UndirectedGraph<int> graph;
+        double buildTime = MeasureMilliseconds([&]() { builder.BuildGraph(graph, threads); });
+
+        std::cout << "  " << threads << " writer(s): ConcurrentHashTable " << edgeCount / tableTime / 1000
+                  << " M updates/s, ConcurrentEdgeBuilder " << edgeCount / builderTime / 1000
+                  << " M edges/s, BuildGraph " << buildTime << " ms\n";
+    }
+}
+
+// Append throughput of DynamicArray against std::vector, for a cheap and for an allocating element type.
+void BenchmarkAppend()
+{
+    int count = 10000000;
+    int stringCount = 1000000;
+
+    std::cout << "Append throughput, M elements/s:\n";
+
+    double arrayTime = MeasureMilliseconds([&]() {
+        DynamicArray<int> array;
+
+        for (int i = 0; i < count; i++)
+            array.Append(i);
+    });
+
+    double reservedTime = MeasureMilliseconds([&]() {
+        DynamicArray<int> array;
+        array.Reserve(count);
+
+        for (int i = 0; i < count; i++)
+            array.EmplaceBack(i);
+    });
+
+    double vectorTime = MeasureMilliseconds([&]() {
+        std::vector<int> vector;
+
+        for (int i = 0; i < count; i++)
+            vector.push_back(i);
+    });
+
+    double edgeTime = MeasureMilliseconds([&]() {
+        DynamicArray<Edge> array;
+
+        for (int i = 0; i < count; i++)
+            array.EmplaceBack(i, 1);
+    });
+
+    double stringTime = MeasureMilliseconds([&]() {
+        DynamicArray<std::string> array;
+
+        for (int i = 0; i < stringCount; i++)
+            array.EmplaceBack(32, 'x');
+    });
+
+    double stringVectorTime = MeasureMilliseconds([&]() {
+        std::vector<std::string> vector;
+
+        for (int i = 0; i < stringCount; i++)
+            vector.emplace_back(32, 'x');
+    });
+
+    std::cout << "  int     Append " << count / arrayTime / 1000 << ", Reserve + EmplaceBack " << count / reservedTime / 1000
+              << ", std::vector " << count / vectorTime / 1000 << "\n";
+    std::cout << "  Edge    EmplaceBack " << count / edgeTime / 1000 << "\n";
+    std::cout << "  string  EmplaceBack " << stringCount / stringTime / 1000 << ", std::vector " << stringCount / stringVectorTime / 1000 << "\n";
+}
+
+void RunBenchmarks()
+{
+    BenchmarkDijkstra();
+    BenchmarkAlt();
+    BenchmarkContractionHierarchies();
+    BenchmarkDeltaStepping();
+    BenchmarkBatchDistances();
+    BenchmarkFloydWarshall();
+    BenchmarkDenseDijkstra();
+    BenchmarkDynamicShortestPaths();
+    BenchmarkMinimumSpanningTree();
+    BenchmarkDynamicMinimumSpanningTree();
+    BenchmarkColoring();
+    BenchmarkParallelColoring();
+    BenchmarkBulkLoad();
+    BenchmarkHashTables();
+    BenchmarkHashTableRemoval();
+    BenchmarkConcurrentIngestion();
+    BenchmarkAppend();
+
+    std::cout << "\n";
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "concurrent_hash_table.h"
+#include "dynamic_array.h"
+#include "undirected_graph.h"
+#include "edge.h"
+
+
+
+// Parallel bulk loader: several threads collect edges at once, e.g. parser threads that split one edge list
+// among them, and BuildGraph hands the result to UndirectedGraph::BuildFromEdges. It is a staging area, not a
+// graph; nothing reads neighbors from it. Keys are ints, like the endpoints of WeightedEdge.
+// Every edge is appended once, to the list of its smaller endpoint in a ConcurrentHashTable, so an insert takes a
+// single shard lock for the edge and never scans a list. The larger endpoint is only registered as a vertex,
+// under a shared lock once it is known. Duplicates are kept until BuildGraph, whose BuildFromEdges call sorts
+// them away anyway.
+class ConcurrentEdgeBuilder {
+private:
+
+    ConcurrentHashTable<int, DynamicArray<Edge>> adjacency;
+
+public:
+
+    explicit ConcurrentEdgeBuilder(int capacity = 20, int shardCount = 0) : adjacency(capacity, shardCount) {}
+
+    void AddVertex(int vertex)
+    {
+        if (!adjacency.ContainsKey(vertex))
+            adjacency.TryEmplace(vertex);
+    }
+
+    // Unlike UndirectedGraph::AddEdge, missing endpoints are added. A repeated edge keeps the weight that
+    // reached the list of its smaller endpoint first, whichever thread added it.
+    void AddEdge(int vertex1, int vertex2, int weight)
+    {
+        int owner = std::min(vertex1, vertex2);
+        int other = std::max(vertex1, vertex2);
+
+        adjacency.AddOrUpdate(owner, [&](DynamicArray<Edge>& edges) { edges.EmplaceBack(other, weight); });
+
+        if (other != owner)
+            AddVertex(other);
+    }
+
+    // Every vertex added explicitly or as an endpoint.
+    int GetVertexCount() const
+    {
+        return adjacency.GetCount();
+    }
+
+    // Edges added so far, repeated ones included.
+    long long GetEdgeCount() const
+    {
+        long long count = 0;
+
+        adjacency.ForEach([&](int vertex, const DynamicArray<Edge>& list) { count += list.GetLength(); });
+
+        return count;
+    }
+
+    // Adds the vertices in ascending key order, then all edges in bulk. Not to be called while threads still
+    // add edges.
+    void BuildGraph(UndirectedGraph<int>& graph, int threadCount = 0) const
+    {
+        std::vector<int> vertices;
+        std::vector<WeightedEdge> edges;
+        vertices.reserve(adjacency.GetCount());
+
+        // each list keeps its insertion order, so the first weight of a repeated edge comes first here as well
+        adjacency.ForEach([&](int vertex, const DynamicArray<Edge>& list) {
+            vertices.push_back(vertex);
+
+            for (int i = 0; i < list.GetLength(); i++)
+                edges.push_back(WeightedEdge(vertex, list[i].vertex, list[i].weight));
+        });
+
+        std::sort(vertices.begin(), vertices.end());
+
+        for (int vertex : vertices)
+            graph.AddVertex(vertex);
+
+        graph.BuildFromEdges(edges, threadCount);
+    }
+};
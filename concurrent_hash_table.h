@@ -0,0 +1,234 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+
+#include "idictionary.h"
+#include "flat_hash_table.h"
+
+
+
+// Thread-safe dictionary made of lock-striped shards: a key picks one of a power-of-two number of shards by
+// its hash, and every shard is a FlatHashTable behind its own reader-writer lock. Readers of a shard run
+// side by side; a writer only excludes the keys of its own shard, and a shard that grows rehashes alone, so
+// the table resizes piece by piece while the other shards stay available. Shards sit on separate cache lines.
+//
+// The IDictionary calls are safe from any thread. Find and GetOrInsert hand out pointers into a shard that
+// outlive its lock, so they are only for phases without concurrent writers; concurrent code reads with
+// GetValue or Visit and writes with Add, TryEmplace or AddOrUpdate.
+template <typename TKey, typename TValue, typename Hash = std::hash<TKey>>
+class ConcurrentHashTable : public IDictionary<TKey, TValue>
+{
+private:
+
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        FlatHashTable<TKey, TValue, Hash> table;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    int shardCount;
+    int shardBits;
+    std::atomic<int> size;
+    Hash hashFunction;
+
+    // FlatHashTable takes its positions from another mix of the same hash, so different bits pick the shard.
+    template <typename TLookup>
+    Shard& GetShard(const TLookup& key) const
+    {
+        if (shardBits == 0)
+            return shards[0];
+
+        uint64_t mixed = (uint64_t)hashFunction(key) * 0xD6E8FEB86659FD93ULL;
+
+        return shards[mixed >> (64 - shardBits)];
+    }
+
+public:
+
+    // The default shard count is a few shards per hardware thread, so writers rarely meet on one lock.
+    static int GetDefaultShardCount()
+    {
+        int threads = (int)std::thread::hardware_concurrency();
+
+        return std::max(16, 8 * std::max(1, threads));
+    }
+
+    explicit ConcurrentHashTable(int capacity = 20, int shardCount = 0) : size(0)
+    {
+        if (shardCount <= 0)
+            shardCount = GetDefaultShardCount();
+
+        shardBits = 0;
+
+        while ((1 << shardBits) < shardCount)
+            shardBits++;
+
+        this->shardCount = 1 << shardBits;
+        shards = std::make_unique<Shard[]>(this->shardCount);
+
+        if (capacity > 0)
+            for (int i = 0; i < this->shardCount; i++)
+                shards[i].table = FlatHashTable<TKey, TValue, Hash>(capacity / this->shardCount + 1);
+    }
+
+    ConcurrentHashTable(const ConcurrentHashTable&) = delete;
+    ConcurrentHashTable& operator=(const ConcurrentHashTable&) = delete;
+
+    int GetCount() const override
+    {
+        return size.load(std::memory_order_relaxed);
+    }
+
+    int GetCapacity() const override
+    {
+        int capacity = 0;
+
+        for (int i = 0; i < shardCount; i++)
+        {
+            std::shared_lock lock(shards[i].mutex);
+            capacity += shards[i].table.GetCapacity();
+        }
+
+        return capacity;
+    }
+
+    int GetShardCount() const
+    {
+        return shardCount;
+    }
+
+    std::optional<TValue> GetValue(const TKey& key) const override
+    {
+        Shard& shard = GetShard(key);
+        std::shared_lock lock(shard.mutex);
+
+        return shard.table.GetValue(key);
+    }
+
+    bool ContainsKey(const TKey& key) const override
+    {
+        Shard& shard = GetShard(key);
+        std::shared_lock lock(shard.mutex);
+
+        return shard.table.ContainsKey(key);
+    }
+
+    void Add(const TKey& key, const TValue& value) override
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock(shard.mutex);
+        auto [stored, inserted] = shard.table.TryEmplace(key, value);
+
+        if (inserted)
+            size.fetch_add(1, std::memory_order_relaxed);
+        else
+            *stored = value;
+    }
+
+    bool Remove(const TKey& key) override
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock(shard.mutex);
+
+        if (!shard.table.Remove(key))
+            return false;
+
+        size.fetch_sub(1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    // Not synchronized beyond the lookup itself, see the class comment.
+    TValue* Find(const TKey& key) override
+    {
+        Shard& shard = GetShard(key);
+        std::shared_lock lock(shard.mutex);
+
+        return shard.table.Find(key);
+    }
+
+    const TValue* Find(const TKey& key) const override
+    {
+        Shard& shard = GetShard(key);
+        std::shared_lock lock(shard.mutex);
+
+        return shard.table.Find(key);
+    }
+
+    TValue& GetOrInsert(const TKey& key, const TValue& value = TValue()) override
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock(shard.mutex);
+        auto [stored, inserted] = shard.table.TryEmplace(key, value);
+
+        if (inserted)
+            size.fetch_add(1, std::memory_order_relaxed);
+
+        return *stored;
+    }
+
+    // Inserts a value built from args unless the key is present; returns whether it was inserted.
+    template <typename... TArgs>
+    bool TryEmplace(const TKey& key, TArgs&&... args)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock(shard.mutex);
+        bool inserted = shard.table.TryEmplace(key, std::forward<TArgs>(args)...).second;
+
+        if (inserted)
+            size.fetch_add(1, std::memory_order_relaxed);
+
+        return inserted;
+    }
+
+    // Calls update(value) under the lock of the shard, after inserting TValue() for an absent key.
+    template <typename TFunction>
+    void AddOrUpdate(const TKey& key, TFunction update)
+    {
+        Shard& shard = GetShard(key);
+        std::unique_lock lock(shard.mutex);
+        auto [stored, inserted] = shard.table.TryEmplace(key);
+
+        if (inserted)
+            size.fetch_add(1, std::memory_order_relaxed);
+
+        update(*stored);
+    }
+
+    // Calls visit(value) under a shared lock if the key is present; returns whether it was.
+    template <typename TFunction>
+    bool Visit(const TKey& key, TFunction visit) const
+    {
+        Shard& shard = GetShard(key);
+        std::shared_lock lock(shard.mutex);
+        const TValue* value = shard.table.Find(key);
+
+        if (value)
+            visit(*value);
+
+        return value != nullptr;
+    }
+
+    // Calls function(key, value) for every entry, one shard at a time under its shared lock.
+    template <typename TFunction>
+    void ForEach(TFunction function) const
+    {
+        for (int i = 0; i < shardCount; i++)
+        {
+            std::shared_lock lock(shards[i].mutex);
+            const FlatHashTable<TKey, TValue, Hash>& table = shards[i].table;
+
+            for (int index = 0; index < table.GetCapacity(); index++)
+                if (table.ConstainsIndex(index))
+                    function(table.GetKeyByIndex(index), table.GetValueByIndex(index));
+        }
+    }
+};
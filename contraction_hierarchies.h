@@ -0,0 +1,465 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "priority_queues.h"
+#include "thread_pool.h"
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+
+
+// Contraction hierarchies for static graphs.
+// Vertices are contracted in rounds of independent sets (no two adjacent), chosen as local minima of
+// the priority "shortcuts added - degree + contracted neighbours". Witness searches and priority updates
+// of a round run on the thread pool; shortcuts are applied sequentially between rounds.
+// The result is an upward graph: every vertex keeps only the arcs to vertices contracted after it.
+template <typename TKey>
+class ContractionHierarchy {
+private:
+
+    struct Arc {
+        int target;
+        int weight;
+    };
+
+    // Per-thread state of the local Dijkstra used to look for witness paths.
+    struct WitnessSearch {
+        BinaryHeap queue;
+        std::vector<int> distances;
+        std::vector<int> touched;
+        std::vector<char> isTarget;
+    };
+
+    // Witness searches give up after this many settled vertices and add the shortcut anyway;
+    // priorities are only estimates, so their simulated contractions use a tighter limit.
+    static constexpr int contractionSettleLimit = 500;
+    static constexpr int simulationSettleLimit = 60;
+
+    const CsrGraph<TKey>& graph;
+    std::vector<int> rank;
+    std::vector<int> upwardOffsets;
+    std::vector<int> upwardTargets;
+    std::vector<int> upwardWeights;
+    int shortcutCount = 0;
+
+    static void AddArc(std::vector<Arc>& arcs, int target, int weight)
+    {
+        for (auto& arc : arcs)
+        {
+            if (arc.target == target)
+            {
+                if (weight < arc.weight)
+                    arc.weight = weight;
+
+                return;
+            }
+        }
+
+        arcs.push_back({target, weight});
+    }
+
+    // Shortcuts needed to contract vertex; they are appended to shortcuts as (u, w, weight) triples
+    // when shortcuts is not null. Vertices with blocked[x] set are treated as already removed.
+    static int FindShortcuts(const std::vector<std::vector<Arc>>& adjacency, const std::vector<char>& blocked,
+                             int vertex, WitnessSearch& search, std::vector<int>* shortcuts)
+    {
+        int settleLimit = shortcuts ? contractionSettleLimit : simulationSettleLimit;
+        const int infinity = std::numeric_limits<int>::max();
+        const std::vector<Arc>& arcs = adjacency[vertex];
+        int maxOut = 0;
+        int count = 0;
+
+        for (const auto& arc : arcs)
+            maxOut = std::max(maxOut, arc.weight);
+
+        for (int i = 0; i < (int)arcs.size(); i++)
+        {
+            int source = arcs[i].target;
+            int limit = arcs[i].weight + maxOut;
+
+            int targetsLeft = 0;
+
+            for (int j = i + 1; j < (int)arcs.size(); j++)
+            {
+                search.isTarget[arcs[j].target] = true;
+                targetsLeft++;
+            }
+
+            search.queue.Reset((int)adjacency.size());
+            search.distances[source] = 0;
+            search.touched.push_back(source);
+            search.queue.Push(source, 0);
+
+            int settled = 0;
+
+            while (!search.queue.IsEmpty() && settled < settleLimit && targetsLeft > 0)
+            {
+                int current;
+                int distance;
+                search.queue.PopMin(current, distance);
+                settled++;
+
+                if (distance > limit)
+                    break;
+
+                if (search.isTarget[current])
+                    targetsLeft--;
+
+                for (const auto& arc : adjacency[current])
+                {
+                    if (arc.target == vertex || blocked[arc.target])
+                        continue;
+
+                    int candidate = distance + arc.weight;
+
+                    if (candidate < search.distances[arc.target])
+                    {
+                        if (search.distances[arc.target] == infinity)
+                            search.touched.push_back(arc.target);
+
+                        search.distances[arc.target] = candidate;
+                        search.queue.Push(arc.target, candidate);
+                    }
+                }
+            }
+
+            for (int j = i + 1; j < (int)arcs.size(); j++)
+            {
+                int via = arcs[i].weight + arcs[j].weight;
+                search.isTarget[arcs[j].target] = false;
+
+                if (search.distances[arcs[j].target] > via)
+                {
+                    count++;
+
+                    if (shortcuts)
+                    {
+                        shortcuts->push_back(source);
+                        shortcuts->push_back(arcs[j].target);
+                        shortcuts->push_back(via);
+                    }
+                }
+            }
+
+            for (int touched : search.touched)
+                search.distances[touched] = infinity;
+
+            search.touched.clear();
+        }
+
+        return count;
+    }
+
+public:
+
+    // progress(contracted, total) is called after every round when it is set.
+    ContractionHierarchy(const CsrGraph<TKey>& graph, int threadCount = 0,
+                         const std::function<void(int, int)>& progress = nullptr) : graph(graph)
+    {
+        const int infinity = std::numeric_limits<int>::max();
+        int count = graph.GetVertexCount();
+
+        std::vector<std::vector<Arc>> adjacency(count);
+
+        for (int v = 0; v < count; v++)
+            for (int p = graph.NeighborsBegin(v); p < graph.NeighborsEnd(v); p++)
+                if (graph.GetNeighbor(p) != v)
+                    AddArc(adjacency[v], graph.GetNeighbor(p), graph.GetWeight(p));
+
+        ThreadPool pool(threadCount);
+        std::vector<WitnessSearch> searches(pool.GetThreadCount());
+
+        for (auto& search : searches)
+        {
+            search.distances.assign(count, infinity);
+            search.isTarget.assign(count, false);
+        }
+
+        std::vector<char> contracted(count, false);
+        std::vector<char> inRound(count, false);
+        std::vector<int> deletedNeighbors(count, 0);
+        std::vector<int> priority(count, 0);
+        std::vector<std::vector<Arc>> upward(count);
+        rank.assign(count, -1);
+
+        auto UpdatePriorities = [&](const std::vector<int>& vertexes) {
+            pool.ParallelFor((int)vertexes.size(), 64, [&](int thread, int begin, int end) {
+                for (int i = begin; i < end; i++)
+                {
+                    int v = vertexes[i];
+                    int shortcuts = FindShortcuts(adjacency, inRound, v, searches[thread], nullptr);
+                    priority[v] = shortcuts - (int)adjacency[v].size() + deletedNeighbors[v];
+                }
+            });
+        };
+
+        std::vector<int> remaining(count);
+
+        for (int v = 0; v < count; v++)
+            remaining[v] = v;
+
+        UpdatePriorities(remaining);
+
+        int nextRank = 0;
+        std::vector<int> round;
+        std::vector<int> affected;
+        std::vector<char> isAffected(count, false);
+        std::vector<std::vector<int>> roundShortcuts;
+
+        while (!remaining.empty())
+        {
+            // independent set of local priority minima, ties broken by id
+            round.clear();
+
+            for (int v : remaining)
+            {
+                bool isMinimum = true;
+
+                for (const auto& arc : adjacency[v])
+                {
+                    int u = arc.target;
+
+                    if (priority[u] < priority[v] || (priority[u] == priority[v] && u < v))
+                    {
+                        isMinimum = false;
+                        break;
+                    }
+                }
+
+                if (isMinimum)
+                    round.push_back(v);
+            }
+
+            for (int v : round)
+                inRound[v] = true;
+
+            roundShortcuts.assign(round.size(), std::vector<int>());
+
+            pool.ParallelFor((int)round.size(), 16, [&](int thread, int begin, int end) {
+                for (int i = begin; i < end; i++)
+                    FindShortcuts(adjacency, inRound, round[i], searches[thread], &roundShortcuts[i]);
+            });
+
+            affected.clear();
+
+            for (int i = 0; i < (int)round.size(); i++)
+            {
+                int v = round[i];
+
+                rank[v] = nextRank++;
+                contracted[v] = true;
+                upward[v] = adjacency[v];
+
+                for (const auto& arc : adjacency[v])
+                {
+                    int u = arc.target;
+                    std::vector<Arc>& arcs = adjacency[u];
+
+                    for (int j = 0; j < (int)arcs.size(); j++)
+                    {
+                        if (arcs[j].target == v)
+                        {
+                            arcs[j] = arcs.back();
+                            arcs.pop_back();
+                            break;
+                        }
+                    }
+
+                    deletedNeighbors[u]++;
+
+                    if (!isAffected[u])
+                    {
+                        isAffected[u] = true;
+                        affected.push_back(u);
+                    }
+                }
+
+                const std::vector<int>& shortcuts = roundShortcuts[i];
+
+                for (int j = 0; j < (int)shortcuts.size(); j += 3)
+                {
+                    AddArc(adjacency[shortcuts[j]], shortcuts[j + 1], shortcuts[j + 2]);
+                    AddArc(adjacency[shortcuts[j + 1]], shortcuts[j], shortcuts[j + 2]);
+                    shortcutCount++;
+                }
+
+                adjacency[v].clear();
+                adjacency[v].shrink_to_fit();
+            }
+
+            for (int v : round)
+                inRound[v] = false;
+
+            for (int u : affected)
+                isAffected[u] = false;
+
+            remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                           [&](int v) { return contracted[v]; }), remaining.end());
+
+            UpdatePriorities(affected);
+
+            if (progress)
+                progress(nextRank, count);
+        }
+
+        upwardOffsets.assign(count + 1, 0);
+
+        for (int v = 0; v < count; v++)
+            upwardOffsets[v + 1] = upwardOffsets[v] + (int)upward[v].size();
+
+        upwardTargets.resize(upwardOffsets[count]);
+        upwardWeights.resize(upwardOffsets[count]);
+
+        for (int v = 0; v < count; v++)
+        {
+            int position = upwardOffsets[v];
+
+            for (const auto& arc : upward[v])
+            {
+                upwardTargets[position] = arc.target;
+                upwardWeights[position] = arc.weight;
+                position++;
+            }
+        }
+    }
+
+    const CsrGraph<TKey>& GetGraph() const
+    {
+        return graph;
+    }
+
+    int GetRank(int index) const
+    {
+        return rank[index];
+    }
+
+    int GetShortcutCount() const
+    {
+        return shortcutCount;
+    }
+
+    int UpwardBegin(int index) const
+    {
+        return upwardOffsets[index];
+    }
+
+    int UpwardEnd(int index) const
+    {
+        return upwardOffsets[index + 1];
+    }
+
+    int GetUpwardTarget(int position) const
+    {
+        return upwardTargets[position];
+    }
+
+    int GetUpwardWeight(int position) const
+    {
+        return upwardWeights[position];
+    }
+};
+
+
+// Bidirectional upward search on a ContractionHierarchy. Scratch buffers are reused between queries.
+template <typename TKey, typename TQueue = BinaryHeap>
+class ContractionHierarchyQuery {
+private:
+
+    const ContractionHierarchy<TKey>& hierarchy;
+    TQueue queues[2];
+    std::vector<int> distances[2];
+    std::vector<unsigned> reached[2];
+    unsigned stamp = 0;
+    int settledCount = 0;
+
+public:
+
+    explicit ContractionHierarchyQuery(const ContractionHierarchy<TKey>& hierarchy) : hierarchy(hierarchy)
+    {
+        int count = hierarchy.GetGraph().GetVertexCount();
+
+        for (int side = 0; side < 2; side++)
+        {
+            distances[side].resize(count);
+            reached[side].resize(count, 0);
+        }
+    }
+
+    int Distance(TKey source, TKey target)
+    {
+        const int infinity = std::numeric_limits<int>::max();
+        const CsrGraph<TKey>& graph = hierarchy.GetGraph();
+        int endpoints[2] = {graph.GetIndex(source), graph.GetIndex(target)};
+
+        if (endpoints[0] == -1 || endpoints[1] == -1)
+            throw std::invalid_argument("Vertex not found in the graph.");
+
+        if (++stamp == 0)
+        {
+            std::fill(reached[0].begin(), reached[0].end(), 0);
+            std::fill(reached[1].begin(), reached[1].end(), 0);
+            stamp = 1;
+        }
+
+        settledCount = 0;
+        int best = infinity;
+
+        for (int side = 0; side < 2; side++)
+        {
+            queues[side].Reset(graph.GetVertexCount());
+            distances[side][endpoints[side]] = 0;
+            reached[side][endpoints[side]] = stamp;
+            queues[side].Push(endpoints[side], 0);
+        }
+
+        int side = 0;
+
+        while (true)
+        {
+            bool active[2];
+
+            for (int s = 0; s < 2; s++)
+                active[s] = !queues[s].IsEmpty() && queues[s].PeekMinKey() < best;
+
+            if (!active[0] && !active[1])
+                break;
+
+            if (!active[side])
+                side = 1 - side;
+
+            int vertex;
+            int distance;
+            queues[side].PopMin(vertex, distance);
+            settledCount++;
+
+            if (reached[1 - side][vertex] == stamp && distance + distances[1 - side][vertex] < best)
+                best = distance + distances[1 - side][vertex];
+
+            for (int p = hierarchy.UpwardBegin(vertex); p < hierarchy.UpwardEnd(vertex); p++)
+            {
+                int neighbor = hierarchy.GetUpwardTarget(p);
+                int candidate = distance + hierarchy.GetUpwardWeight(p);
+
+                if (reached[side][neighbor] != stamp || candidate < distances[side][neighbor])
+                {
+                    distances[side][neighbor] = candidate;
+                    reached[side][neighbor] = stamp;
+                    queues[side].Push(neighbor, candidate);
+                }
+            }
+
+            side = 1 - side;
+        }
+
+        return best;
+    }
+
+    int GetSettledCount() const
+    {
+        return settledCount;
+    }
+};
@@ -0,0 +1,231 @@
+#pragma once
+
+#include "dynamic_array.h"
+#include "edge.h"
+#include "disjoint_set.h"
+#include "flat_hash_table.h"
+
+#include <memory>
+#include <mutex>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+
+
+// Immutable compressed-sparse-row snapshot of an UndirectedGraph.
+// Vertices get dense ids 0..V-1 in the same order as UndirectedGraph::GetVertex,
+// so results of the algorithms below can be printed with the same helpers.
+// Neighbors of vertex i are stored in positions [offsets[i], offsets[i + 1]).
+// The key -> index map is only built by the first GetIndex call, so a snapshot that is only walked by index
+// never hashes its keys. Copies share it, since their keys are the same.
+template <typename TKey>
+class CsrGraph {
+private:
+
+    struct IndexMap {
+        std::once_flag built;
+        FlatHashTable<TKey, int> indexes;
+    };
+
+    std::vector<TKey> vertexes;
+    std::shared_ptr<IndexMap> indexMap = std::make_shared<IndexMap>();
+    std::vector<int> offsets;
+    std::vector<int> neighbors;
+    std::vector<int> weights;
+
+public:
+
+    CsrGraph() : offsets(1, 0) {}
+
+    CsrGraph(std::vector<TKey> vertexes, std::vector<int> offsets, std::vector<int> neighbors, std::vector<int> weights)
+            : vertexes(std::move(vertexes)),
+              offsets(std::move(offsets)),
+              neighbors(std::move(neighbors)),
+              weights(std::move(weights))
+    {
+        if (this->offsets.size() != this->vertexes.size() + 1 || this->neighbors.size() != this->weights.size())
+            throw std::invalid_argument("Inconsistent CSR arrays.");
+    }
+
+    int GetVertexCount() const
+    {
+        return (int)vertexes.size();
+    }
+
+    // Every undirected edge is stored twice, once per endpoint.
+    int GetEdgeCount() const
+    {
+        return (int)neighbors.size() / 2;
+    }
+
+    TKey GetVertex(int index) const
+    {
+        if (index < 0 || index >= (int)vertexes.size())
+            return TKey();
+
+        return vertexes[index];
+    }
+
+    // Safe to call from several threads; the first call builds the map.
+    int GetIndex(const TKey& vertex) const
+    {
+        std::call_once(indexMap->built, [this]() {
+            indexMap->indexes.Reserve((int)vertexes.size());
+
+            for (int i = 0; i < (int)vertexes.size(); i++)
+                indexMap->indexes.Add(vertexes[i], i);
+        });
+
+        const int* index = indexMap->indexes.Find(vertex);
+
+        return index ? *index : -1;
+    }
+
+    int GetDegree(int index) const
+    {
+        return offsets[index + 1] - offsets[index];
+    }
+
+    int NeighborsBegin(int index) const
+    {
+        return offsets[index];
+    }
+
+    int NeighborsEnd(int index) const
+    {
+        return offsets[index + 1];
+    }
+
+    int GetNeighbor(int position) const
+    {
+        return neighbors[position];
+    }
+
+    int GetWeight(int position) const
+    {
+        return weights[position];
+    }
+
+    DynamicArray<int> ColorGraph() const
+    {
+        int count = GetVertexCount();
+        DynamicArray<int> colors(count);
+
+        // forbidden[c] == i means color c is taken by a neighbor of vertex i
+        std::vector<int> forbidden(count + 1, -1);
+
+        for (int i = 0; i < count; i++)
+            colors.Set(i, -1);
+
+        for (int i = 0; i < count; i++)
+        {
+            for (int p = offsets[i]; p < offsets[i + 1]; p++)
+            {
+                int neighborColor = colors[neighbors[p]];
+
+                if (neighborColor != -1)
+                    forbidden[neighborColor] = i;
+            }
+
+            int color = 0;
+            while (forbidden[color] == i)
+                color++;
+
+            colors.Set(i, color);
+        }
+
+        return colors;
+    }
+
+    DynamicArray<int> DiijkstaAlgorithm(TKey startVertex) const
+    {
+        int count = GetVertexCount();
+        int startIndex = GetIndex(startVertex);
+
+        if (startIndex == -1)
+            throw std::invalid_argument("Start vertex not found in the graph.");
+
+        std::vector<int> distances(count, std::numeric_limits<int>::max());
+        std::vector<char> visited(count, false);
+        distances[startIndex] = 0;
+
+        for (int i = 0; i < count; i++)
+        {
+            int minDistance = std::numeric_limits<int>::max();
+            int minIndex = -1;
+
+            for (int j = 0; j < count; j++)
+            {
+                if (!visited[j] && distances[j] < minDistance)
+                {
+                    minDistance = distances[j];
+                    minIndex = j;
+                }
+            }
+
+            if (minIndex == -1) break;
+
+            visited[minIndex] = true;
+
+            for (int p = offsets[minIndex]; p < offsets[minIndex + 1]; p++)
+            {
+                int neighborIndex = neighbors[p];
+
+                if (!visited[neighborIndex] && minDistance + weights[p] < distances[neighborIndex])
+                    distances[neighborIndex] = minDistance + weights[p];
+            }
+        }
+
+        DynamicArray<int> result(count);
+
+        for (int i = 0; i < count; i++)
+            result.Set(i, distances[i]);
+
+        return result;
+    }
+
+    // Same output contract as UndirectedGraph::FindMinimumSpanningTreeKruskal.
+    DynamicArray<Edge> FindMinimumSpanningTreeKruskal() const
+    {
+        DynamicArray<Edge> mst;
+        int count = GetVertexCount();
+
+        if (count == 0)
+            return mst;
+
+        struct IndexedEdge {
+            int weight;
+            int u;
+            int v;
+        };
+
+        std::vector<IndexedEdge> edges;
+        edges.reserve(neighbors.size() / 2);
+
+        for (int u = 0; u < count; u++)
+            for (int p = offsets[u]; p < offsets[u + 1]; p++)
+                if (vertexes[u] < vertexes[neighbors[p]])
+                    edges.push_back({weights[p], u, neighbors[p]});
+
+        std::sort(edges.begin(), edges.end(), [this](const IndexedEdge& a, const IndexedEdge& b) {
+            if (a.weight != b.weight)
+                return a.weight < b.weight;
+            if (vertexes[a.u] != vertexes[b.u])
+                return vertexes[a.u] < vertexes[b.u];
+            return vertexes[a.v] < vertexes[b.v];
+        });
+
+        DisjointSet components(count);
+        mst.Reserve(count > 0 ? count - 1 : 0);
+
+        for (const auto& edge : edges)
+        {
+            if (components.Union(edge.u, edge.v))
+                mst.Append(Edge(vertexes[edge.v], edge.weight));
+        }
+
+        return mst;
+    }
+};
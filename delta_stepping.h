@@ -0,0 +1,218 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "thread_pool.h"
+
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+
+
+// Parallel delta-stepping single-source shortest paths (Meyer, Sanders).
+// Tentative distances are kept in buckets of width delta. All vertices of the current bucket are relaxed
+// in parallel: light edges (weight <= delta) repeatedly until the bucket stays empty, then heavy edges once.
+// Distances are lowered with an atomic minimum, so relaxations from different threads may race freely.
+// Weights must be non-negative.
+class DeltaSteppingEngine {
+private:
+
+    ThreadPool pool;
+    std::vector<int> distances;
+    std::vector<std::vector<int>> buckets;          // cyclic: bucket i lives in buckets[i % size]
+    std::vector<std::vector<int>> threadRequests;
+    std::vector<int> frontier;
+    std::vector<int> removed;
+    std::vector<unsigned> frontierStamp;
+    std::vector<unsigned> removedStamp;
+    unsigned stamp = 0;
+
+    static bool LowerDistance(int& target, int candidate)
+    {
+        std::atomic_ref<int> distance(target);
+        int current = distance.load(std::memory_order_relaxed);
+
+        while (candidate < current)
+            if (distance.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+                return true;
+
+        return false;
+    }
+
+    unsigned NextStamp()
+    {
+        if (++stamp == 0)
+        {
+            std::fill(frontierStamp.begin(), frontierStamp.end(), 0);
+            std::fill(removedStamp.begin(), removedStamp.end(), 0);
+            stamp = 1;
+        }
+
+        return stamp;
+    }
+
+    template <typename TKey>
+    void Relax(const CsrGraph<TKey>& graph, const std::vector<int>& vertexes, int delta, bool light)
+    {
+        pool.ParallelFor((int)vertexes.size(), 256, [&](int thread, int begin, int end) {
+            std::vector<int>& requests = threadRequests[thread];
+
+            for (int i = begin; i < end; i++)
+            {
+                int vertex = vertexes[i];
+                int distance = std::atomic_ref<int>(distances[vertex]).load(std::memory_order_relaxed);
+
+                for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+                {
+                    int weight = graph.GetWeight(p);
+
+                    if ((weight <= delta) != light)
+                        continue;
+
+                    int neighbor = graph.GetNeighbor(p);
+
+                    if (LowerDistance(distances[neighbor], distance + weight))
+                        requests.push_back(neighbor);
+                }
+            }
+        });
+
+        for (auto& requests : threadRequests)
+        {
+            for (int vertex : requests)
+                buckets[(distances[vertex] / delta) % buckets.size()].push_back(vertex);
+
+            requests.clear();
+        }
+    }
+
+public:
+
+    explicit DeltaSteppingEngine(int threadCount = 0) : pool(threadCount), threadRequests(pool.GetThreadCount()) {}
+
+    int GetThreadCount() const
+    {
+        return pool.GetThreadCount();
+    }
+
+    // Default delta from the weight distribution: the maximum weight divided by the average degree
+    // (the Meyer-Sanders choice for random weights), but never below the smallest weight.
+    template <typename TKey>
+    static int ChooseDelta(const CsrGraph<TKey>& graph)
+    {
+        int minWeight = std::numeric_limits<int>::max();
+        int maxWeight = 0;
+        long long entries = 0;
+
+        for (int v = 0; v < graph.GetVertexCount(); v++)
+        {
+            for (int p = graph.NeighborsBegin(v); p < graph.NeighborsEnd(v); p++)
+            {
+                minWeight = std::min(minWeight, graph.GetWeight(p));
+                maxWeight = std::max(maxWeight, graph.GetWeight(p));
+                entries++;
+            }
+        }
+
+        if (entries == 0)
+            return 1;
+
+        double averageDegree = (double)entries / graph.GetVertexCount();
+        int delta = (int)(maxWeight / std::max(1.0, averageDegree));
+
+        return std::max({1, minWeight, delta});
+    }
+
+    // delta <= 0 picks ChooseDelta(graph); a delta far below the largest weight is widened, see below.
+    template <typename TKey>
+    const std::vector<int>& Run(const CsrGraph<TKey>& graph, int sourceIndex, int delta = 0)
+    {
+        int count = graph.GetVertexCount();
+
+        if (sourceIndex < 0 || sourceIndex >= count)
+            throw std::invalid_argument("Start vertex not found in the graph.");
+
+        if (delta <= 0)
+            delta = ChooseDelta(graph);
+
+        int maxWeight = 0;
+
+        for (int v = 0; v < count; v++)
+            for (int p = graph.NeighborsBegin(v); p < graph.NeighborsEnd(v); p++)
+                maxWeight = std::max(maxWeight, graph.GetWeight(p));
+
+        // a relaxation from bucket i never reaches past bucket i + maxWeight / delta + 1; a delta too small for
+        // the weight range is widened so that the ring stays within count + 2 buckets
+        if (maxWeight / delta > count)
+            delta = maxWeight / count + 1;
+
+        buckets.assign(maxWeight / delta + 2, std::vector<int>());
+        distances.assign(count, std::numeric_limits<int>::max());
+        frontierStamp.resize(count, 0);
+        removedStamp.resize(count, 0);
+
+        distances[sourceIndex] = 0;
+        buckets[0].push_back(sourceIndex);
+
+        int current = 0;
+        int emptyInARow = 0;
+
+        while (emptyInARow < (int)buckets.size())
+        {
+            std::vector<int>& bucket = buckets[current % buckets.size()];
+
+            if (bucket.empty())
+            {
+                emptyInARow++;
+                current++;
+                continue;
+            }
+
+            emptyInARow = 0;
+            removed.clear();
+            unsigned removedMark = NextStamp();
+
+            while (!bucket.empty())
+            {
+                unsigned frontierMark = NextStamp();
+                frontier.clear();
+
+                for (int vertex : bucket)
+                {
+                    if (distances[vertex] / delta != current || frontierStamp[vertex] == frontierMark)
+                        continue;
+
+                    frontierStamp[vertex] = frontierMark;
+                    frontier.push_back(vertex);
+
+                    if (removedStamp[vertex] != removedMark)
+                    {
+                        removedStamp[vertex] = removedMark;
+                        removed.push_back(vertex);
+                    }
+                }
+
+                bucket.clear();
+                Relax(graph, frontier, delta, true);
+            }
+
+            Relax(graph, removed, delta, false);
+            current++;
+        }
+
+        return distances;
+    }
+
+    const std::vector<int>& GetDistances() const
+    {
+        return distances;
+    }
+
+    // Length of the bucket ring used by the last Run.
+    int GetBucketCount() const
+    {
+        return (int)buckets.size();
+    }
+};
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "dijkstra_engine.h"
+#include "simd.h"
+
+#include <vector>
+#include <limits>
+#include <stdexcept>
+
+
+
+// O(V^2) Dijkstra for dense graphs with a vectorized minimum search.
+// Tentative distances live in one aligned array where settled vertices (and the padding up to a multiple of
+// the vector width) hold the INT_MAX sentinel, so picking the next vertex is a plain argmin reduction.
+class DenseDijkstraEngine {
+private:
+
+    static constexpr int padding = 8;
+
+    AlignedIntBuffer keys;
+    std::vector<int> distances;
+    std::vector<char> settled;
+
+    static int ArgMinScalar(const int* values, int length)
+    {
+        int best = std::numeric_limits<int>::max();
+        int bestIndex = -1;
+
+        for (int i = 0; i < length; i++)
+        {
+            if (values[i] < best)
+            {
+                best = values[i];
+                bestIndex = i;
+            }
+        }
+
+        return bestIndex;
+    }
+
+#ifdef GRAPH_SIMD_X86
+    // Picks the smallest value, the lowest index among equal ones; -1 if everything is INT_MAX.
+    static int FinishArgMin(const int* values, const int* indexes, int lanes)
+    {
+        int best = std::numeric_limits<int>::max();
+        int bestIndex = -1;
+
+        for (int lane = 0; lane < lanes; lane++)
+        {
+            if (values[lane] < best || (values[lane] == best && bestIndex != -1 && indexes[lane] < bestIndex))
+            {
+                best = values[lane];
+                bestIndex = indexes[lane];
+            }
+        }
+
+        return best == std::numeric_limits<int>::max() ? -1 : bestIndex;
+    }
+
+    GRAPH_TARGET_SSE2 static int ArgMinSse2(const int* values, int length)
+    {
+        __m128i best = _mm_set1_epi32(std::numeric_limits<int>::max());
+        __m128i bestIndex = _mm_set1_epi32(-1);
+        __m128i index = _mm_setr_epi32(0, 1, 2, 3);
+        __m128i step = _mm_set1_epi32(4);
+
+        for (int i = 0; i < length; i += 4)
+        {
+            __m128i current = _mm_load_si128((const __m128i*)(values + i));
+            __m128i smaller = _mm_cmpgt_epi32(best, current);
+            best = _mm_or_si128(_mm_and_si128(smaller, current), _mm_andnot_si128(smaller, best));
+            bestIndex = _mm_or_si128(_mm_and_si128(smaller, index), _mm_andnot_si128(smaller, bestIndex));
+            index = _mm_add_epi32(index, step);
+        }
+
+        alignas(16) int laneValues[4];
+        alignas(16) int laneIndexes[4];
+        _mm_store_si128((__m128i*)laneValues, best);
+        _mm_store_si128((__m128i*)laneIndexes, bestIndex);
+
+        return FinishArgMin(laneValues, laneIndexes, 4);
+    }
+
+    GRAPH_TARGET_AVX2 static int ArgMinAvx2(const int* values, int length)
+    {
+        __m256i best = _mm256_set1_epi32(std::numeric_limits<int>::max());
+        __m256i bestIndex = _mm256_set1_epi32(-1);
+        __m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i step = _mm256_set1_epi32(8);
+
+        for (int i = 0; i < length; i += 8)
+        {
+            __m256i current = _mm256_load_si256((const __m256i*)(values + i));
+            __m256i smaller = _mm256_cmpgt_epi32(best, current);
+            best = _mm256_min_epi32(best, current);
+            bestIndex = _mm256_blendv_epi8(bestIndex, index, smaller);
+            index = _mm256_add_epi32(index, step);
+        }
+
+        alignas(32) int laneValues[8];
+        alignas(32) int laneIndexes[8];
+        _mm256_store_si256((__m256i*)laneValues, best);
+        _mm256_store_si256((__m256i*)laneIndexes, bestIndex);
+
+        return FinishArgMin(laneValues, laneIndexes, 8);
+    }
+#endif
+
+    static int ArgMin(SimdLevel level, const int* values, int length)
+    {
+#ifdef GRAPH_SIMD_X86
+        if (level == SimdLevel::Avx2)
+            return ArgMinAvx2(values, length);
+
+        if (level == SimdLevel::Sse2)
+            return ArgMinSse2(values, length);
+#endif
+
+        return ArgMinScalar(values, length);
+    }
+
+public:
+
+    template <typename TKey>
+    const std::vector<int>& Run(const CsrGraph<TKey>& graph, int sourceIndex, SimdLevel level = SimdLevel::Avx2)
+    {
+        const int infinity = std::numeric_limits<int>::max();
+        int count = graph.GetVertexCount();
+
+        if (sourceIndex < 0 || sourceIndex >= count)
+            throw std::invalid_argument("Start vertex not found in the graph.");
+
+        level = LimitSimdLevel(level);
+
+        int length = (count + padding - 1) / padding * padding;
+        keys.Resize(length);
+
+        for (int i = 0; i < length; i++)
+            keys[i] = infinity;
+
+        distances.assign(count, infinity);
+        settled.assign(count, false);
+        keys[sourceIndex] = 0;
+
+        while (true)
+        {
+            int vertex = ArgMin(level, keys.GetData(), length);
+
+            if (vertex == -1)
+                break;
+
+            int distance = keys[vertex];
+            distances[vertex] = distance;
+            settled[vertex] = true;
+            keys[vertex] = infinity;
+
+            for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+            {
+                int neighbor = graph.GetNeighbor(p);
+                int candidate = distance + graph.GetWeight(p);
+
+                if (!settled[neighbor] && candidate < keys[neighbor])
+                    keys[neighbor] = candidate;
+            }
+        }
+
+        return distances;
+    }
+
+    const std::vector<int>& GetDistances() const
+    {
+        return distances;
+    }
+};
+
+
+enum class DijkstraMode {
+    Auto,
+    Dense,
+    Heap
+};
+
+// Picks the dense engine for graphs with more than V^2 / 4 edges (average degree above V / 2) and the heap
+// engine otherwise. With an indexed heap only a small share of the relaxations turns into decrease-key
+// operations, so the heap stays ahead until the graph is close to complete.
+class AdaptiveDijkstraEngine {
+private:
+
+    DenseDijkstraEngine dense;
+    DijkstraEngine<QuaternaryHeap> heap;
+    DijkstraMode lastMode = DijkstraMode::Auto;
+
+public:
+
+    static DijkstraMode ChooseMode(int vertexCount, int edgeCount)
+    {
+        if ((double)edgeCount * 4 > (double)vertexCount * vertexCount)
+            return DijkstraMode::Dense;
+
+        return DijkstraMode::Heap;
+    }
+
+    template <typename TKey>
+    const std::vector<int>& Run(const CsrGraph<TKey>& graph, int sourceIndex, DijkstraMode mode = DijkstraMode::Auto)
+    {
+        if (mode == DijkstraMode::Auto)
+            mode = ChooseMode(graph.GetVertexCount(), graph.GetEdgeCount());
+
+        lastMode = mode;
+
+        if (mode == DijkstraMode::Dense)
+            return dense.Run(graph, sourceIndex);
+
+        return heap.Run(graph, sourceIndex);
+    }
+
+    // Mode the last Run actually used.
+    DijkstraMode GetLastMode() const
+    {
+        return lastMode;
+    }
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "priority_queues.h"
+
+#include <vector>
+#include <limits>
+#include <stdexcept>
+
+
+
+// Priority-queue based Dijkstra, O((V + E) log V) with the heaps from priority_queues.h.
+// The engine keeps its buffers between runs, so repeated runs on graphs of the same size do not allocate.
+// UndirectedGraph::DiijkstaAlgorithm stays the O(V^2) path for dense graphs.
+template <typename TQueue = BinaryHeap>
+class DijkstraEngine {
+private:
+
+    TQueue queue;
+    std::vector<int> distances;
+    std::vector<char> settled;
+    int settledCount = 0;
+
+public:
+
+    template <typename TKey>
+    const std::vector<int>& Run(const CsrGraph<TKey>& graph, int sourceIndex)
+    {
+        int count = graph.GetVertexCount();
+
+        if (sourceIndex < 0 || sourceIndex >= count)
+            throw std::invalid_argument("Start vertex not found in the graph.");
+
+        distances.assign(count, std::numeric_limits<int>::max());
+        settled.assign(count, false);
+        settledCount = 0;
+        queue.Reset(count);
+
+        distances[sourceIndex] = 0;
+        queue.Push(sourceIndex, 0);
+
+        while (!queue.IsEmpty())
+        {
+            int vertex;
+            int distance;
+            queue.PopMin(vertex, distance);
+
+            settled[vertex] = true;
+            settledCount++;
+
+            for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+            {
+                int neighbor = graph.GetNeighbor(p);
+                int candidate = distance + graph.GetWeight(p);
+
+                if (!settled[neighbor] && candidate < distances[neighbor])
+                {
+                    distances[neighbor] = candidate;
+                    queue.Push(neighbor, candidate);
+                }
+            }
+        }
+
+        return distances;
+    }
+
+    const std::vector<int>& GetDistances() const
+    {
+        return distances;
+    }
+
+    int GetSettledCount() const
+    {
+        return settledCount;
+    }
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+
+
+// Union-find over dense ids 0..n-1 in two flat arrays: union by size, find with path halving.
+class DisjointSet {
+private:
+
+    std::vector<int> parent;
+    std::vector<int> size;
+    int setCount = 0;
+
+public:
+
+    explicit DisjointSet(int count = 0)
+    {
+        Reset(count);
+    }
+
+    // Every id becomes its own set; buffers are kept.
+    void Reset(int count)
+    {
+        parent.resize(count);
+        size.assign(count, 1);
+        setCount = count;
+
+        for (int i = 0; i < count; i++)
+            parent[i] = i;
+    }
+
+    int Find(int vertex)
+    {
+        while (parent[vertex] != vertex)
+        {
+            parent[vertex] = parent[parent[vertex]];
+            vertex = parent[vertex];
+        }
+
+        return vertex;
+    }
+
+    // Find without path halving; safe to call from many threads while nobody calls Find or Union.
+    int FindRoot(int vertex) const
+    {
+        while (parent[vertex] != vertex)
+            vertex = parent[vertex];
+
+        return vertex;
+    }
+
+    // false if both were already in one set.
+    bool Union(int vertex1, int vertex2)
+    {
+        int root1 = Find(vertex1);
+        int root2 = Find(vertex2);
+
+        if (root1 == root2)
+            return false;
+
+        if (size[root1] < size[root2])
+            std::swap(root1, root2);
+
+        parent[root2] = root1;
+        size[root1] += size[root2];
+        setCount--;
+
+        return true;
+    }
+
+    bool Connected(int vertex1, int vertex2)
+    {
+        return Find(vertex1) == Find(vertex2);
+    }
+
+    int GetSetCount() const
+    {
+        return setCount;
+    }
+
+    int GetCount() const
+    {
+        return (int)parent.size();
+    }
+};
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "undirected_graph.h"
+#include "dynamic_array.h"
+
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <cstddef>
+
+
+
+// LRU cache of DiijkstaAlgorithm results keyed by (start vertex, graph version).
+// Any mutation gives the graph a new version, so stale results are never returned; they just age out.
+// The budget counts the distance arrays plus a fixed per-entry overhead, in bytes.
+template <typename TKey>
+class DistanceCache {
+private:
+
+    struct CacheKey {
+        TKey source;
+        unsigned long long version;
+
+        bool operator==(const CacheKey& other) const
+        {
+            return source == other.source && version == other.version;
+        }
+    };
+
+    struct CacheKeyHash {
+        std::size_t operator()(const CacheKey& key) const
+        {
+            std::size_t hash = std::hash<TKey>()(key.source);
+
+            return hash ^ (std::hash<unsigned long long>()(key.version) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+        }
+    };
+
+    struct CacheEntry {
+        CacheKey key;
+        DynamicArray<int> distances;
+        std::size_t bytes;
+    };
+
+    static constexpr std::size_t entryOverhead = sizeof(CacheEntry) + 4 * sizeof(void*);
+
+    std::list<CacheEntry> entries;      // most recently used first
+    std::unordered_map<CacheKey, typename std::list<CacheEntry>::iterator, CacheKeyHash> index;
+    std::size_t budget;
+    std::size_t usedBytes = 0;
+    long long hits = 0;
+    long long misses = 0;
+    long long evictions = 0;
+
+    void EvictUntilFits(std::size_t incoming)
+    {
+        while (!entries.empty() && usedBytes + incoming > budget)
+        {
+            usedBytes -= entries.back().bytes;
+            index.erase(entries.back().key);
+            entries.pop_back();
+            evictions++;
+        }
+    }
+
+public:
+
+    explicit DistanceCache(std::size_t budgetBytes = 64 * 1024 * 1024) : budget(budgetBytes) {}
+
+    DynamicArray<int> GetDistances(UndirectedGraph<TKey>& graph, TKey source)
+    {
+        CacheKey key{source, graph.GetVersion()};
+        auto it = index.find(key);
+
+        if (it != index.end())
+        {
+            hits++;
+            entries.splice(entries.begin(), entries, it->second);
+
+            return it->second->distances;
+        }
+
+        misses++;
+
+        DynamicArray<int> distances = graph.DiijkstaAlgorithm(source);
+        std::size_t bytes = GetEntryBytes(distances.GetLength());
+
+        // results larger than the whole budget are handed out but not kept
+        if (bytes > budget)
+            return distances;
+
+        EvictUntilFits(bytes);
+
+        entries.push_front(CacheEntry{key, distances, bytes});
+        index[key] = entries.begin();
+        usedBytes += bytes;
+
+        return distances;
+    }
+
+    // Budget charged for one cached result on a graph with vertexCount vertices.
+    static std::size_t GetEntryBytes(int vertexCount)
+    {
+        return entryOverhead + sizeof(int) * (std::size_t)vertexCount;
+    }
+
+    void SetBudget(std::size_t budgetBytes)
+    {
+        budget = budgetBytes;
+        EvictUntilFits(0);
+    }
+
+    void Clear()
+    {
+        entries.clear();
+        index.clear();
+        usedBytes = 0;
+    }
+
+    std::size_t GetBudget() const
+    {
+        return budget;
+    }
+
+    std::size_t GetUsedBytes() const
+    {
+        return usedBytes;
+    }
+
+    int GetCount() const
+    {
+        return (int)entries.size();
+    }
+
+    long long GetHitCount() const
+    {
+        return hits;
+    }
+
+    long long GetMissCount() const
+    {
+        return misses;
+    }
+
+    long long GetEvictionCount() const
+    {
+        return evictions;
+    }
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+
+
+// Row-major distance matrix: row r holds the distances from the r-th source to every vertex,
+// columns follow the dense vertex order of the CsrGraph.
+class DistanceMatrix {
+private:
+
+    int rowCount = 0;
+    int columnCount = 0;
+    std::vector<int> data;
+
+public:
+
+    DistanceMatrix() = default;
+
+    DistanceMatrix(int rowCount, int columnCount)
+            : rowCount(rowCount), columnCount(columnCount), data((size_t)rowCount * columnCount) {}
+
+    // Changes the shape without giving memory back, so a tile can be refilled without allocating.
+    void Reshape(int rows, int columns)
+    {
+        rowCount = rows;
+        columnCount = columns;
+        data.resize((size_t)rows * columns);
+    }
+
+    int GetRowCount() const
+    {
+        return rowCount;
+    }
+
+    int GetColumnCount() const
+    {
+        return columnCount;
+    }
+
+    int Get(int row, int column) const
+    {
+        return data[(size_t)row * columnCount + column];
+    }
+
+    int* GetRow(int row)
+    {
+        return data.data() + (size_t)row * columnCount;
+    }
+
+    const int* GetRow(int row) const
+    {
+        return data.data() + (size_t)row * columnCount;
+    }
+};
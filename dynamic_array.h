@@ -1,279 +1,365 @@
-#pragma once
-
-#include <stdexcept>
-
-#include "sequence.h"
-
-
-
-template <class T>
-class DynamicArray : public Sequence<T>
-{
-private:
-
-    T* data;
-    int size;
-
-    void Resize(int newSize)
-    {
-        T* newData = new T[newSize];
-
-        int minSize = (newSize < size) ? newSize : size;
-
-        for (int i = 0; i < minSize; ++i)
-        {
-            newData[i] = data[i];
-        }
-
-        delete[] data;
-        data = newData;
-        size = newSize;
-    }
-
-public:
-    class DynamicArrayIterator : public Sequence<T>::Iterator {
-    private:
-
-        T* current;
-
-    public:
-
-        DynamicArrayIterator(T* current) : current(current) {}
-
-        bool operator==(const typename Sequence<T>::Iterator& other) const override
-        {
-            const DynamicArrayIterator* otherIterator = dynamic_cast<const DynamicArrayIterator*>(&other);
-            return otherIterator && current == otherIterator->current;
-        }
-
-        bool operator!=(const typename Sequence<T>::Iterator& other) const override
-        {
-            return !(*this == other);
-        }
-
-        T& operator*() const override
-        {
-            return *current;
-        }
-
-        typename Sequence<T>::Iterator& operator++() override
-        {
-            current++;
-
-            return *this;
-        }
-    };
-
-    typename Sequence<T>::Iterator* ToBegin() const override
-    {
-        return new DynamicArrayIterator(data);
-    }
-
-    typename Sequence<T>::Iterator* ToEnd() const override
-    {
-        return new DynamicArrayIterator(data + size);
-    }
-
-    DynamicArray(T* items, int size)
-    {
-        this->size = size;
-        data = new T[size];
-
-        for (int i = 0; i < size; ++i)
-        {
-            Set(i, items[i]);
-        }
-    }
-
-    DynamicArray(T example, int size)
-    {
-        this->size = size;
-        data = new T[size];
-
-        for (int i = 0; i < size; ++i)
-        {
-            Set(i, example);
-        }
-    }
-
-    DynamicArray(int size = 0)
-    {
-        this->size = size;
-        data = new T[size];
-    }
-
-    DynamicArray(const DynamicArray& other)
-    {
-        size = other.size;
-        data = new T[size];
-
-        for (int i = 0; i < size; ++i)
-        {
-            data[i] = other.data[i];
-        }
-    }
-
-    DynamicArray& operator=(const DynamicArray& other)
-    {
-        if (this == &other)
-            return *this;
-
-        delete[] data;
-
-        size = other.size;
-        data = new T[size];
-
-        for (int i = 0; i < size; ++i)
-        {
-            data[i] = other.data[i];
-        }
-
-        return *this;
-    }
-
-    bool operator==(const DynamicArray& other) const {
-        if (size != other.size)
-        {
-            return false;
-        }
-
-        for (int i = 0; i < size; ++i)
-            if (data[i] != other.data[i])
-                return false;
-
-        return true;
-    }
-
-    ~DynamicArray()
-    {
-        if (data)
-        {
-            delete[] data;
-        }
-    }
-
-    T& operator[](int index)
-    {
-        return data[index];
-    }
-
-    T& operator[](int index) const
-    {
-        return data[index];
-    }
-
-    T& GetFirstElement() override
-    {
-        return GetElement(0);
-    }
-
-    T& GetLastElement() override
-    {
-        return GetElement(size - 1);
-    }
-
-    T& GetElement(int index) override
-    {
-        return data[index];
-    }
-
-    void Swap(T& ConstainsIndex, T& GetKeyByIndex) override
-    {
-        T temp = ConstainsIndex;
-        ConstainsIndex = GetKeyByIndex;
-        GetKeyByIndex = temp;
-    }
-
-    void Set(int index, T value) override
-    {
-        data[index] = value;
-    }
-
-    DynamicArray<T>* GetSubsequence(int startIndex, int endIndex) override
-    {
-        int length;
-
-        if (endIndex > size)
-        {
-            length = size - startIndex;
-        }
-        else
-        {
-            length = endIndex - startIndex + 1;
-
-            if (startIndex == 0)
-            {
-                length -= 1;
-            }
-        }
-
-        T* items = new T[length];
-
-        for (int i = 0; i < length; i++)
-        {
-            items[i] = GetElement(startIndex + i);
-        }
-
-        return new DynamicArray<T>(items, length);
-    }
-
-    int GetLength() const override
-    {
-        return size;
-    }
-
-    void Append(T data) override
-    {
-        InsertAt(data, size);
-    }
-
-    void Append(T* data, int dataSize) override
-    {
-        int oldSize = size;
-
-        Resize(size + dataSize);
-
-        for (int i = oldSize; i < oldSize + dataSize; i++)
-        {
-            Set(i, data[i - oldSize]);
-        }
-    }
-
-    void Prepend(T data) override
-    {
-        InsertAt(data, 0);
-    }
-
-    void InsertAt(T data, int index) override
-    {
-        Resize(size + 1);
-
-        for (int i = size - 1; i > index; i--)
-        {
-            Set(i, GetElement(i - 1));
-        }
-
-        Set(index, data);
-    }
-
-    void Union(Sequence<T>* dynamicArray) override
-    {
-        int oldSize = size;
-
-        for (int i = 0; i < dynamicArray->GetLength(); i++)
-        {
-            Append(dynamicArray->GetElement(i));
-        }
-    }
-
-    void Remove(int index) override
-    {
-        for (int i = index; i < size - 1; i++)
-        {
-            Set(i, GetElement(i + 1));
-        }
-
-        Resize(size - 1);
-    }
-};
-
+#pragma once
+
+#include <stdexcept>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <new>
+
+#include "sequence.h"
+
+
+
+// Contiguous array with a separate capacity. Appends grow the capacity geometrically, so a sequence of n
+// appends costs O(n) element moves in total; spare slots stay raw memory until an element is constructed in
+// them. Remove keeps the capacity, ShrinkToFit gives the spare memory back.
+template <class T>
+class DynamicArray : public Sequence<T>
+{
+private:
+
+    T* data;
+    int size;
+    int capacity;
+
+    static T* Allocate(int count)
+    {
+        return count == 0 ? nullptr : std::allocator<T>().allocate(count);
+    }
+
+    // Destroys the elements and frees the buffer; the array is left without a buffer.
+    void Release()
+    {
+        std::destroy(data, data + size);
+
+        if (data)
+            std::allocator<T>().deallocate(data, capacity);
+
+        data = nullptr;
+        size = 0;
+        capacity = 0;
+    }
+
+    // Moves the elements into a buffer of newCapacity >= size elements.
+    void Reallocate(int newCapacity)
+    {
+        T* newData = Allocate(newCapacity);
+        std::uninitialized_move(data, data + size, newData);
+        AdoptBuffer(newData, newCapacity);
+    }
+
+    // Replaces the buffer by newData, which already holds the moved elements.
+    void AdoptBuffer(T* newData, int newCapacity)
+    {
+        std::destroy(data, data + size);
+
+        if (data)
+            std::allocator<T>().deallocate(data, capacity);
+
+        data = newData;
+        capacity = newCapacity;
+    }
+
+    int GetGrownCapacity(int required) const
+    {
+        return std::max(required, std::max(4, capacity * 2));
+    }
+
+    void CopyFrom(const T* items, int count)
+    {
+        data = Allocate(count);
+        capacity = count;
+        std::uninitialized_copy(items, items + count, data);
+        size = count;
+    }
+
+public:
+    class DynamicArrayIterator : public Sequence<T>::Iterator {
+    private:
+
+        T* current;
+
+    public:
+
+        DynamicArrayIterator(T* current) : current(current) {}
+
+        bool operator==(const typename Sequence<T>::Iterator& other) const override
+        {
+            const DynamicArrayIterator* otherIterator = dynamic_cast<const DynamicArrayIterator*>(&other);
+            return otherIterator && current == otherIterator->current;
+        }
+
+        bool operator!=(const typename Sequence<T>::Iterator& other) const override
+        {
+            return !(*this == other);
+        }
+
+        T& operator*() const override
+        {
+            return *current;
+        }
+
+        typename Sequence<T>::Iterator& operator++() override
+        {
+            current++;
+
+            return *this;
+        }
+    };
+
+    typename Sequence<T>::Iterator* ToBegin() const override
+    {
+        return new DynamicArrayIterator(data);
+    }
+
+    typename Sequence<T>::Iterator* ToEnd() const override
+    {
+        return new DynamicArrayIterator(data + size);
+    }
+
+    DynamicArray(T* items, int size) : data(nullptr), size(0), capacity(0)
+    {
+        CopyFrom(items, size);
+    }
+
+    DynamicArray(T example, int size) : data(Allocate(size)), size(size), capacity(size)
+    {
+        std::uninitialized_fill(data, data + size, example);
+    }
+
+    // Value-initialized elements, i.e. zeros for arithmetic types.
+    DynamicArray(int size = 0) : data(Allocate(size)), size(size), capacity(size)
+    {
+        std::uninitialized_value_construct(data, data + size);
+    }
+
+    DynamicArray(const DynamicArray& other) : data(nullptr), size(0), capacity(0)
+    {
+        CopyFrom(other.data, other.size);
+    }
+
+    DynamicArray(DynamicArray&& other) noexcept : data(other.data), size(other.size), capacity(other.capacity)
+    {
+        other.data = nullptr;
+        other.size = 0;
+        other.capacity = 0;
+    }
+
+    DynamicArray& operator=(const DynamicArray& other)
+    {
+        if (this == &other)
+            return *this;
+
+        // the buffer is reused when it is large enough
+        if (other.size <= capacity)
+        {
+            // the length drops first, so a throwing copy never leaves destroyed elements counted
+            std::destroy(data, data + size);
+            size = 0;
+            std::uninitialized_copy(other.data, other.data + other.size, data);
+            size = other.size;
+        }
+        else
+        {
+            Release();
+            CopyFrom(other.data, other.size);
+        }
+
+        return *this;
+    }
+
+    DynamicArray& operator=(DynamicArray&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        Release();
+        data = other.data;
+        size = other.size;
+        capacity = other.capacity;
+        other.data = nullptr;
+        other.size = 0;
+        other.capacity = 0;
+
+        return *this;
+    }
+
+    bool operator==(const DynamicArray& other) const {
+        if (size != other.size)
+        {
+            return false;
+        }
+
+        for (int i = 0; i < size; ++i)
+            if (data[i] != other.data[i])
+                return false;
+
+        return true;
+    }
+
+    ~DynamicArray()
+    {
+        Release();
+    }
+
+    T& operator[](int index)
+    {
+        return data[index];
+    }
+
+    T& operator[](int index) const
+    {
+        return data[index];
+    }
+
+    T& GetFirstElement() override
+    {
+        return GetElement(0);
+    }
+
+    T& GetLastElement() override
+    {
+        return GetElement(size - 1);
+    }
+
+    T& GetElement(int index) override
+    {
+        return data[index];
+    }
+
+    void Swap(T& ConstainsIndex, T& GetKeyByIndex) override
+    {
+        T temp = ConstainsIndex;
+        ConstainsIndex = GetKeyByIndex;
+        GetKeyByIndex = temp;
+    }
+
+    void Set(int index, T value) override
+    {
+        data[index] = std::move(value);
+    }
+
+    DynamicArray<T>* GetSubsequence(int startIndex, int endIndex) override
+    {
+        int length;
+
+        if (endIndex > size)
+        {
+            length = size - startIndex;
+        }
+        else
+        {
+            length = endIndex - startIndex + 1;
+
+            if (startIndex == 0)
+            {
+                length -= 1;
+            }
+        }
+
+        return new DynamicArray<T>(data + startIndex, length);
+    }
+
+    int GetLength() const override
+    {
+        return size;
+    }
+
+    // Slots allocated, used or not.
+    int GetCapacity() const
+    {
+        return capacity;
+    }
+
+    // Makes room for count elements without changing the length.
+    void Reserve(int count)
+    {
+        if (count > capacity)
+            Reallocate(count);
+    }
+
+    // Frees the spare slots.
+    void ShrinkToFit()
+    {
+        if (capacity > size)
+            Reallocate(size);
+    }
+
+    // Destroys all elements and keeps the capacity.
+    void Clear()
+    {
+        std::destroy(data, data + size);
+        size = 0;
+    }
+
+    // Constructs the new last element from args in place and returns it.
+    template <typename... TArgs>
+    T& EmplaceBack(TArgs&&... args)
+    {
+        if (size < capacity)
+        {
+            new (data + size) T(std::forward<TArgs>(args)...);
+        }
+        else
+        {
+            // the new element is built before the old ones move, since args may refer to one of them
+            int newCapacity = GetGrownCapacity(size + 1);
+            T* newData = Allocate(newCapacity);
+            new (newData + size) T(std::forward<TArgs>(args)...);
+            std::uninitialized_move(data, data + size, newData);
+            AdoptBuffer(newData, newCapacity);
+        }
+
+        return data[size++];
+    }
+
+    void Append(T data) override
+    {
+        EmplaceBack(std::move(data));
+    }
+
+    void Append(T* data, int dataSize) override
+    {
+        if (size + dataSize <= capacity)
+        {
+            std::uninitialized_copy(data, data + dataSize, this->data + size);
+        }
+        else
+        {
+            // copied before the old buffer goes away, in case data points into it
+            int newCapacity = GetGrownCapacity(size + dataSize);
+            T* newData = Allocate(newCapacity);
+            std::uninitialized_copy(data, data + dataSize, newData + size);
+            std::uninitialized_move(this->data, this->data + size, newData);
+            AdoptBuffer(newData, newCapacity);
+        }
+
+        size += dataSize;
+    }
+
+    void Prepend(T data) override
+    {
+        InsertAt(std::move(data), 0);
+    }
+
+    void InsertAt(T data, int index) override
+    {
+        EmplaceBack(std::move(data));
+        std::rotate(this->data + index, this->data + size - 1, this->data + size);
+    }
+
+    void Union(Sequence<T>* dynamicArray) override
+    {
+        for (int i = 0; i < dynamicArray->GetLength(); i++)
+        {
+            Append(dynamicArray->GetElement(i));
+        }
+    }
+
+    void Remove(int index) override
+    {
+        std::move(data + index + 1, data + size, data + index);
+        std::destroy_at(data + size - 1);
+        size--;
+    }
+};
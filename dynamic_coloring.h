@@ -0,0 +1,381 @@
+#pragma once
+
+#include "undirected_graph.h"
+#include "graph_observer.h"
+#include "graph_coloring.h"
+#include "dynamic_array.h"
+
+#include <vector>
+#include <unordered_map>
+#include <stdexcept>
+#include <algorithm>
+
+
+
+// Proper coloring that follows the graph through its observer interface.
+// Only an inserted edge between two vertices of the same color breaks the coloring. The endpoint of smaller
+// degree then takes the smallest color free among its neighbors, which costs O(degree). Optionally, when that
+// color would grow the palette, Kempe-chain swaps are tried first: for colors a and b, the (a, b)-chains through
+// the a-colored neighbors are swapped if they do not reach a b-colored neighbor, which frees a. Pairs of colors
+// rare among the neighbors go first, at most kempeAttemptLimit pairs are tried and chains longer than
+// kempeLimit vertices are abandoned, so a repair stays within O(kempeAttemptLimit * kempeLimit * degree).
+// Self-loops cannot be colored properly and are left out of the neighbor lists, as ColorGraph ignores them.
+// Removals never break a coloring; the palette size (highest color in use + 1) is kept up to date with a
+// per-color counter.
+template <typename TKey>
+class DynamicColoring : public IGraphObserver<TKey> {
+private:
+
+    static constexpr int kempeAttemptLimit = 16;
+
+    UndirectedGraph<TKey>& graph;
+    ColoringOrder initialOrder;
+    bool useKempeChains;
+    int kempeLimit;
+
+    std::unordered_map<TKey, int> indexes;
+    std::vector<std::vector<int>> adjacency;
+    std::vector<int> colors;
+    std::vector<int> freeSlots;
+    std::vector<int> usage;
+    int paletteSize = 0;
+
+    std::vector<int> forbidden;
+    std::vector<int> visitStamp;
+    std::vector<int> chain;
+    std::vector<int> neighborColorCounts;
+    std::vector<int> candidates;
+    int stamp = 0;
+    long long recolorCount = 0;
+    long long kempeSwapCount = 0;
+
+    void SetColor(int vertex, int color)
+    {
+        if (colors[vertex] != -1)
+        {
+            usage[colors[vertex]]--;
+
+            while (paletteSize > 0 && usage[paletteSize - 1] == 0)
+                paletteSize--;
+        }
+
+        colors[vertex] = color;
+
+        if (color == -1)
+            return;
+
+        if (color >= (int)usage.size())
+            usage.resize(color + 1, 0);
+
+        usage[color]++;
+        paletteSize = std::max(paletteSize, color + 1);
+    }
+
+    int NextStamp()
+    {
+        if (++stamp == 0)
+        {
+            std::fill(forbidden.begin(), forbidden.end(), 0);
+            std::fill(visitStamp.begin(), visitStamp.end(), 0);
+            stamp = 1;
+        }
+
+        return stamp;
+    }
+
+    int SmallestFreeColor(int vertex)
+    {
+        int mark = NextStamp();
+
+        if ((int)forbidden.size() < (int)adjacency[vertex].size() + 1)
+            forbidden.resize(adjacency[vertex].size() + 1, 0);
+
+        for (int neighbor : adjacency[vertex])
+            if (colors[neighbor] != -1 && colors[neighbor] < (int)forbidden.size())
+                forbidden[colors[neighbor]] = mark;
+
+        int color = 0;
+
+        while (color < (int)forbidden.size() && forbidden[color] == mark)
+            color++;
+
+        return color;
+    }
+
+    // Swaps a and b on the chains through the a-colored neighbors of vertex, so that a becomes free there.
+    bool TryKempeSwap(int vertex, int a, int b)
+    {
+        int mark = NextStamp();
+        chain.clear();
+        visitStamp[vertex] = mark;
+
+        for (int neighbor : adjacency[vertex])
+        {
+            if (colors[neighbor] == a && visitStamp[neighbor] != mark)
+            {
+                visitStamp[neighbor] = mark;
+                chain.push_back(neighbor);
+            }
+        }
+
+        for (int i = 0; i < (int)chain.size(); i++)
+        {
+            if ((int)chain.size() > kempeLimit)
+                return false;
+
+            for (int next : adjacency[chain[i]])
+            {
+                if (next == vertex || visitStamp[next] == mark || (colors[next] != a && colors[next] != b))
+                    continue;
+
+                visitStamp[next] = mark;
+                chain.push_back(next);
+            }
+        }
+
+        // a b-colored neighbor inside the chain would turn a after the swap
+        for (int neighbor : adjacency[vertex])
+            if (colors[neighbor] == b && visitStamp[neighbor] == mark)
+                return false;
+
+        for (int member : chain)
+            SetColor(member, colors[member] == a ? b : a);
+
+        kempeSwapCount++;
+
+        return true;
+    }
+
+    // Every palette color is on a neighbor here, so the palette is at most the degree. A color on few
+    // neighbors has few chains to swap, which makes those pairs the likeliest to succeed.
+    bool TryKempeRepair(int vertex, int current)
+    {
+        neighborColorCounts.assign(paletteSize, 0);
+        candidates.clear();
+
+        for (int neighbor : adjacency[vertex])
+            if (colors[neighbor] != -1 && neighborColorCounts[colors[neighbor]]++ == 0)
+                candidates.push_back(colors[neighbor]);
+
+        std::sort(candidates.begin(), candidates.end(), [&](int first, int second) {
+            return neighborColorCounts[first] < neighborColorCounts[second];
+        });
+
+        int attempts = 0;
+
+        for (int a : candidates)
+        {
+            if (a == current)
+                continue;
+
+            for (int b : candidates)
+            {
+                if (b == a)
+                    continue;
+
+                if (attempts++ == kempeAttemptLimit)
+                    return false;
+
+                if (TryKempeSwap(vertex, a, b))
+                {
+                    SetColor(vertex, a);
+
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void Recolor(int vertex)
+    {
+        recolorCount++;
+
+        int color = SmallestFreeColor(vertex);
+        int current = colors[vertex];
+
+        if (useKempeChains && color >= paletteSize && TryKempeRepair(vertex, current))
+            return;
+
+        SetColor(vertex, color);
+    }
+
+    int AddSlot(const TKey& vertex)
+    {
+        int index;
+
+        if (freeSlots.empty())
+        {
+            index = (int)colors.size();
+            adjacency.emplace_back();
+            colors.push_back(-1);
+            visitStamp.push_back(0);
+        }
+        else
+        {
+            index = freeSlots.back();
+            freeSlots.pop_back();
+        }
+
+        indexes[vertex] = index;
+
+        return index;
+    }
+
+    int FindIndex(const TKey& vertex) const
+    {
+        auto it = indexes.find(vertex);
+
+        return it == indexes.end() ? -1 : it->second;
+    }
+
+public:
+
+    // The graph has to outlive this object. The starting coloring comes from ColoringEngine.
+    explicit DynamicColoring(UndirectedGraph<TKey>& graph, bool useKempeChains = false, int kempeLimit = 64,
+                             ColoringOrder initialOrder = ColoringOrder::Dsatur)
+            : graph(graph), initialOrder(initialOrder), useKempeChains(useKempeChains), kempeLimit(kempeLimit)
+    {
+        Rebuild();
+        graph.Subscribe(this);
+    }
+
+    DynamicColoring(const DynamicColoring&) = delete;
+    DynamicColoring& operator=(const DynamicColoring&) = delete;
+
+    ~DynamicColoring() override
+    {
+        graph.Unsubscribe(this);
+    }
+
+    // Colors the current graph from scratch.
+    void Rebuild()
+    {
+        CsrGraph<TKey> csr = graph.Freeze();
+        ColoringEngine engine;
+        const std::vector<int>& initial = engine.Run(csr, initialOrder);
+
+        indexes.clear();
+        adjacency.assign(csr.GetVertexCount(), std::vector<int>());
+        colors.assign(csr.GetVertexCount(), -1);
+        visitStamp.assign(csr.GetVertexCount(), 0);
+        freeSlots.clear();
+        usage.clear();
+        paletteSize = 0;
+
+        for (int i = 0; i < csr.GetVertexCount(); i++)
+        {
+            indexes[csr.GetVertex(i)] = i;
+
+            for (int p = csr.NeighborsBegin(i); p < csr.NeighborsEnd(i); p++)
+                if (csr.GetNeighbor(p) != i)
+                    adjacency[i].push_back(csr.GetNeighbor(p));
+
+            SetColor(i, initial[i]);
+        }
+    }
+
+    void OnVertexAdded(const TKey& vertex) override
+    {
+        SetColor(AddSlot(vertex), 0);
+    }
+
+    // Every incident edge has been reported by now, so the slot is isolated and can be reused.
+    void OnVertexRemoved(const TKey& vertex) override
+    {
+        int index = FindIndex(vertex);
+
+        if (index == -1)
+            return;
+
+        SetColor(index, -1);
+        adjacency[index].clear();
+        indexes.erase(vertex);
+        freeSlots.push_back(index);
+    }
+
+    void OnEdgeAdded(const TKey& vertex1, const TKey& vertex2, int weight) override
+    {
+        int u = FindIndex(vertex1);
+        int v = FindIndex(vertex2);
+
+        // self-loops stay out of the neighbor lists, as in Rebuild
+        if (u == v)
+            return;
+
+        adjacency[u].push_back(v);
+        adjacency[v].push_back(u);
+
+        if (colors[u] == colors[v])
+            Recolor(adjacency[u].size() <= adjacency[v].size() ? u : v);
+    }
+
+    void OnEdgeRemoved(const TKey& vertex1, const TKey& vertex2, int weight) override
+    {
+        int u = FindIndex(vertex1);
+        int v = FindIndex(vertex2);
+
+        auto eraseNeighbor = [&](int from, int to) {
+            std::vector<int>& neighbors = adjacency[from];
+
+            for (int i = 0; i < (int)neighbors.size(); i++)
+            {
+                if (neighbors[i] == to)
+                {
+                    neighbors[i] = neighbors.back();
+                    neighbors.pop_back();
+                    break;
+                }
+            }
+        };
+
+        if (u == v)
+            return;
+
+        eraseNeighbor(u, v);
+        eraseNeighbor(v, u);
+    }
+
+    void OnGraphReplaced() override
+    {
+        Rebuild();
+    }
+
+    int GetColor(const TKey& vertex) const
+    {
+        int index = FindIndex(vertex);
+
+        if (index == -1)
+            throw std::invalid_argument("Vertex not found in the graph.");
+
+        return colors[index];
+    }
+
+    // Same layout as ColorGraph: one color per vertex in GetVertex order.
+    DynamicArray<int> GetColors() const
+    {
+        DynamicArray<int> result(graph.GetVertexCount());
+
+        for (int i = 0; i < graph.GetVertexCount(); i++)
+            result.Set(i, colors[FindIndex(graph.GetVertex(i))]);
+
+        return result;
+    }
+
+    // Highest color in use + 1.
+    int GetPaletteSize() const
+    {
+        return paletteSize;
+    }
+
+    long long GetRecolorCount() const
+    {
+        return recolorCount;
+    }
+
+    long long GetKempeSwapCount() const
+    {
+        return kempeSwapCount;
+    }
+};
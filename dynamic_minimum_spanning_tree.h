@@ -0,0 +1,487 @@
+#pragma once
+
+#include "undirected_graph.h"
+#include "graph_observer.h"
+#include "minimum_spanning_tree.h"
+#include "edge.h"
+
+#include <vector>
+#include <unordered_map>
+#include <limits>
+#include <utility>
+
+
+
+// Link-cut tree (Sleator, Tarjan) over a forest whose nodes carry weights, answering "heaviest node on the
+// path between u and v" in O(log n) amortized. Splay trees hold the preferred paths; a lazy flag reverses a
+// path when its other end becomes the root.
+class LinkCutTree {
+private:
+
+    std::vector<int> left;
+    std::vector<int> right;
+    std::vector<int> parent;
+    std::vector<char> reversed;
+    std::vector<int> weights;
+    std::vector<int> heaviest;          // heaviest node in the splay subtree
+    std::vector<int> splayPath;
+
+    bool IsSplayRoot(int node) const
+    {
+        int up = parent[node];
+
+        return up == -1 || (left[up] != node && right[up] != node);
+    }
+
+    void Push(int node)
+    {
+        if (!reversed[node])
+            return;
+
+        std::swap(left[node], right[node]);
+
+        if (left[node] != -1)
+            reversed[left[node]] ^= 1;
+
+        if (right[node] != -1)
+            reversed[right[node]] ^= 1;
+
+        reversed[node] = false;
+    }
+
+    void Update(int node)
+    {
+        heaviest[node] = node;
+
+        if (left[node] != -1 && weights[heaviest[left[node]]] > weights[heaviest[node]])
+            heaviest[node] = heaviest[left[node]];
+
+        if (right[node] != -1 && weights[heaviest[right[node]]] > weights[heaviest[node]])
+            heaviest[node] = heaviest[right[node]];
+    }
+
+    void Rotate(int node)
+    {
+        int up = parent[node];
+        int grand = parent[up];
+
+        if (!IsSplayRoot(up))
+        {
+            if (left[grand] == up)
+                left[grand] = node;
+            else
+                right[grand] = node;
+        }
+
+        parent[node] = grand;
+
+        if (left[up] == node)
+        {
+            left[up] = right[node];
+
+            if (right[node] != -1)
+                parent[right[node]] = up;
+
+            right[node] = up;
+        }
+        else
+        {
+            right[up] = left[node];
+
+            if (left[node] != -1)
+                parent[left[node]] = up;
+
+            left[node] = up;
+        }
+
+        parent[up] = node;
+        Update(up);
+        Update(node);
+    }
+
+    void Splay(int node)
+    {
+        // pending reversals have to be pushed from the top of the splay tree down
+        splayPath.clear();
+
+        for (int current = node; ; current = parent[current])
+        {
+            splayPath.push_back(current);
+
+            if (IsSplayRoot(current))
+                break;
+        }
+
+        for (int i = (int)splayPath.size() - 1; i >= 0; i--)
+            Push(splayPath[i]);
+
+        while (!IsSplayRoot(node))
+        {
+            int up = parent[node];
+
+            if (!IsSplayRoot(up))
+            {
+                int grand = parent[up];
+                bool zigZig = (left[grand] == up) == (left[up] == node);
+                Rotate(zigZig ? up : node);
+            }
+
+            Rotate(node);
+        }
+    }
+
+    // Makes the root-to-node path preferred; node ends up as the root of its splay tree.
+    void Access(int node)
+    {
+        int last = -1;
+
+        for (int current = node; current != -1; current = parent[current])
+        {
+            Splay(current);
+            right[current] = last;
+            Update(current);
+            last = current;
+        }
+
+        Splay(node);
+    }
+
+    void MakeRoot(int node)
+    {
+        Access(node);
+        reversed[node] ^= 1;
+    }
+
+    int FindRoot(int node)
+    {
+        Access(node);
+
+        while (true)
+        {
+            Push(node);
+
+            if (left[node] == -1)
+                break;
+
+            node = left[node];
+        }
+
+        Splay(node);
+
+        return node;
+    }
+
+public:
+
+    void Clear()
+    {
+        left.clear();
+        right.clear();
+        parent.clear();
+        reversed.clear();
+        weights.clear();
+        heaviest.clear();
+    }
+
+    // Appends an isolated node and returns it.
+    int AddNode(int weight)
+    {
+        int node = (int)left.size();
+        left.push_back(-1);
+        right.push_back(-1);
+        parent.push_back(-1);
+        reversed.push_back(false);
+        weights.push_back(weight);
+        heaviest.push_back(node);
+
+        return node;
+    }
+
+    // Only for isolated nodes, e.g. when a slot is reused.
+    void SetWeight(int node, int weight)
+    {
+        weights[node] = weight;
+        heaviest[node] = node;
+    }
+
+    int GetWeight(int node) const
+    {
+        return weights[node];
+    }
+
+    int GetNodeCount() const
+    {
+        return (int)left.size();
+    }
+
+    bool Connected(int node1, int node2)
+    {
+        return node1 == node2 || FindRoot(node1) == FindRoot(node2);
+    }
+
+    // node1 and node2 have to be in different trees.
+    void Link(int node1, int node2)
+    {
+        MakeRoot(node1);
+        parent[node1] = node2;
+    }
+
+    // node1 and node2 have to be adjacent.
+    void Cut(int node1, int node2)
+    {
+        MakeRoot(node1);
+        Access(node2);
+
+        // node1 is now the only node above node2 on the path, i.e. its left child
+        left[node2] = -1;
+        parent[node1] = -1;
+        Update(node2);
+    }
+
+    // Heaviest node on the path between two connected nodes.
+    int FindHeaviest(int node1, int node2)
+    {
+        MakeRoot(node1);
+        Access(node2);
+
+        return heaviest[node2];
+    }
+};
+
+
+// Minimum spanning forest that follows the graph through its observer interface.
+// Every tree edge is a link-cut tree node of its own between its two vertex nodes, so an inserted edge costs
+// O(log V) amortized: if it joins two trees it is linked, otherwise the heaviest edge on the tree path between
+// its endpoints is found and swapped out when the new edge is lighter. Deleting a non-tree edge is free;
+// deleting a tree edge (or assigning a new graph) marks the forest stale, and the next insertion or query
+// rebuilds it from the graph with MinimumSpanningTreeEngine.
+template <typename TKey>
+class DynamicMinimumSpanningTree : public IGraphObserver<TKey> {
+private:
+
+    struct TreeEdge {
+        TKey vertex1;
+        TKey vertex2;
+        int node;
+    };
+
+    struct KeyPairHash {
+        std::size_t operator()(const std::pair<TKey, TKey>& pair) const
+        {
+            std::size_t hash = std::hash<TKey>()(pair.first);
+
+            return hash ^ (std::hash<TKey>()(pair.second) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+        }
+    };
+
+    UndirectedGraph<TKey>& graph;
+    MinimumSpanningTreeEngine engine;
+    LinkCutTree tree;
+    std::unordered_map<TKey, int> vertexNodes;
+    std::vector<int> freeNodes;
+    std::vector<TreeEdge> treeEdges;
+    std::vector<int> treeEdgeSlots;     // node -> position in treeEdges, -1 for vertex and free nodes
+    std::unordered_map<std::pair<TKey, TKey>, int, KeyPairHash> edgeNodes;
+    long long totalWeight = 0;
+    bool stale = false;
+    int rebuildCount = 0;
+
+    static std::pair<TKey, TKey> MakePair(const TKey& vertex1, const TKey& vertex2)
+    {
+        return vertex1 < vertex2 ? std::make_pair(vertex1, vertex2) : std::make_pair(vertex2, vertex1);
+    }
+
+    int AllocateNode(int weight)
+    {
+        if (freeNodes.empty())
+        {
+            treeEdgeSlots.push_back(-1);
+
+            return tree.AddNode(weight);
+        }
+
+        int node = freeNodes.back();
+        freeNodes.pop_back();
+        tree.SetWeight(node, weight);
+
+        return node;
+    }
+
+    void AddTreeEdge(const TKey& vertex1, const TKey& vertex2, int weight)
+    {
+        int node = AllocateNode(weight);
+
+        tree.Link(vertexNodes[vertex1], node);
+        tree.Link(node, vertexNodes[vertex2]);
+
+        treeEdgeSlots[node] = (int)treeEdges.size();
+        treeEdges.push_back(TreeEdge{vertex1, vertex2, node});
+        edgeNodes[MakePair(vertex1, vertex2)] = node;
+        totalWeight += weight;
+    }
+
+    void RemoveTreeEdge(int node)
+    {
+        TreeEdge edge = treeEdges[treeEdgeSlots[node]];
+
+        tree.Cut(vertexNodes[edge.vertex1], node);
+        tree.Cut(node, vertexNodes[edge.vertex2]);
+
+        int slot = treeEdgeSlots[node];
+        treeEdges[slot] = treeEdges.back();
+        treeEdgeSlots[treeEdges[slot].node] = slot;
+        treeEdges.pop_back();
+        treeEdgeSlots[node] = -1;
+
+        edgeNodes.erase(MakePair(edge.vertex1, edge.vertex2));
+        totalWeight -= tree.GetWeight(node);
+        freeNodes.push_back(node);
+    }
+
+    void Refresh()
+    {
+        if (stale)
+            Rebuild();
+    }
+
+public:
+
+    // The graph has to outlive this object.
+    explicit DynamicMinimumSpanningTree(UndirectedGraph<TKey>& graph, int threadCount = 0)
+            : graph(graph), engine(threadCount)
+    {
+        Rebuild();
+        graph.Subscribe(this);
+    }
+
+    DynamicMinimumSpanningTree(const DynamicMinimumSpanningTree&) = delete;
+    DynamicMinimumSpanningTree& operator=(const DynamicMinimumSpanningTree&) = delete;
+
+    ~DynamicMinimumSpanningTree() override
+    {
+        graph.Unsubscribe(this);
+    }
+
+    // Recomputes the forest from the current graph.
+    void Rebuild()
+    {
+        CsrGraph<TKey> csr = graph.Freeze();
+
+        tree.Clear();
+        vertexNodes.clear();
+        freeNodes.clear();
+        treeEdges.clear();
+        treeEdgeSlots.clear();
+        edgeNodes.clear();
+        totalWeight = 0;
+
+        for (int i = 0; i < csr.GetVertexCount(); i++)
+            vertexNodes[csr.GetVertex(i)] = AllocateNode(std::numeric_limits<int>::min());
+
+        for (const WeightedEdge& edge : engine.Run(csr))
+            AddTreeEdge(csr.GetVertex(edge.vertex1), csr.GetVertex(edge.vertex2), edge.weight);
+
+        stale = false;
+        rebuildCount++;
+    }
+
+    void OnVertexAdded(const TKey& vertex) override
+    {
+        if (!stale)
+            vertexNodes[vertex] = AllocateNode(std::numeric_limits<int>::min());
+    }
+
+    // All incident edges are gone by now, so the node is isolated unless the forest is stale anyway.
+    void OnVertexRemoved(const TKey& vertex) override
+    {
+        auto it = vertexNodes.find(vertex);
+
+        if (stale || it == vertexNodes.end())
+            return;
+
+        freeNodes.push_back(it->second);
+        vertexNodes.erase(it);
+    }
+
+    void OnEdgeAdded(const TKey& vertex1, const TKey& vertex2, int weight) override
+    {
+        // a rebuild reads the graph, which already contains the new edge
+        if (stale)
+        {
+            Rebuild();
+            return;
+        }
+
+        if (vertex1 == vertex2)
+            return;
+
+        int node1 = vertexNodes[vertex1];
+        int node2 = vertexNodes[vertex2];
+
+        if (!tree.Connected(node1, node2))
+        {
+            AddTreeEdge(vertex1, vertex2, weight);
+            return;
+        }
+
+        int heaviest = tree.FindHeaviest(node1, node2);
+
+        if (tree.GetWeight(heaviest) <= weight)
+            return;
+
+        RemoveTreeEdge(heaviest);
+        AddTreeEdge(vertex1, vertex2, weight);
+    }
+
+    void OnEdgeRemoved(const TKey& vertex1, const TKey& vertex2, int weight) override
+    {
+        if (!stale && edgeNodes.count(MakePair(vertex1, vertex2)) != 0)
+            stale = true;
+    }
+
+    void OnGraphReplaced() override
+    {
+        stale = true;
+    }
+
+    // Current forest as (key, key, weight) edges, in no particular order.
+    std::vector<WeightedEdge> GetEdges()
+    {
+        Refresh();
+
+        std::vector<WeightedEdge> result;
+        result.reserve(treeEdges.size());
+
+        for (const TreeEdge& edge : treeEdges)
+            result.push_back(WeightedEdge(edge.vertex1, edge.vertex2, tree.GetWeight(edge.node)));
+
+        return result;
+    }
+
+    long long GetTotalWeight()
+    {
+        Refresh();
+
+        return totalWeight;
+    }
+
+    int GetEdgeCount()
+    {
+        Refresh();
+
+        return (int)treeEdges.size();
+    }
+
+    bool ContainsEdge(const TKey& vertex1, const TKey& vertex2)
+    {
+        Refresh();
+
+        return edgeNodes.count(MakePair(vertex1, vertex2)) != 0;
+    }
+
+    // Full recomputations so far, the one in the constructor included.
+    int GetRebuildCount() const
+    {
+        return rebuildCount;
+    }
+};
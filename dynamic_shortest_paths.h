@@ -0,0 +1,359 @@
+#pragma once
+
+#include "undirected_graph.h"
+#include "graph_observer.h"
+#include "priority_queues.h"
+#include "dynamic_array.h"
+
+#include <vector>
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+
+
+// Single-source distances and a shortest-path tree that follow the graph through its observer interface.
+// An inserted edge can only shorten paths, so the improvement is pushed outwards from its endpoints with a
+// decrease-only Dijkstra. A deleted tree edge invalidates the subtree below it (Ramalingam, Reps): vertices of
+// the subtree that still have a neighbour at the same distance outside the invalid part keep their distance,
+// the rest are reset and settled again by a Dijkstra seeded from their valid neighbours.
+// Deleting a non-tree edge changes nothing. Weights must be non-negative.
+// The graph is mirrored into dense ids once and kept in sync by the notifications.
+template <typename TKey, typename TQueue = QuaternaryHeap>
+class DynamicShortestPaths : public IGraphObserver<TKey> {
+private:
+
+    struct Arc {
+        int vertex;
+        int weight;
+    };
+
+    UndirectedGraph<TKey>& graph;
+    TKey source;
+    int sourceIndex = -1;
+
+    std::vector<TKey> keys;
+    std::unordered_map<TKey, int> indexes;
+    std::vector<std::vector<Arc>> adjacency;
+    std::vector<int> distances;
+    std::vector<int> parents;
+
+    TQueue queue;
+    std::vector<char> invalid;
+    std::vector<int> subtree;
+    int touchedCount = 0;
+
+    int AddSlot(const TKey& vertex)
+    {
+        int index = (int)keys.size();
+        keys.push_back(vertex);
+        indexes[vertex] = index;
+        adjacency.emplace_back();
+        distances.push_back(std::numeric_limits<int>::max());
+        parents.push_back(-1);
+        invalid.push_back(false);
+
+        return index;
+    }
+
+    int FindIndex(const TKey& vertex) const
+    {
+        auto it = indexes.find(vertex);
+
+        return it == indexes.end() ? -1 : it->second;
+    }
+
+    // Settles everything in the queue; distances only go down.
+    void Propagate()
+    {
+        while (!queue.IsEmpty())
+        {
+            int vertex;
+            int distance;
+            queue.PopMin(vertex, distance);
+            touchedCount++;
+
+            for (const Arc& arc : adjacency[vertex])
+            {
+                int candidate = distance + arc.weight;
+
+                if (candidate < distances[arc.vertex])
+                {
+                    distances[arc.vertex] = candidate;
+                    parents[arc.vertex] = vertex;
+                    queue.Push(arc.vertex, candidate);
+                }
+            }
+        }
+    }
+
+    void Relax(int from, int to, int weight)
+    {
+        if (distances[from] == std::numeric_limits<int>::max())
+            return;
+
+        int candidate = distances[from] + weight;
+
+        if (candidate < distances[to])
+        {
+            distances[to] = candidate;
+            parents[to] = from;
+            queue.Push(to, candidate);
+        }
+    }
+
+    // Repairs the subtree hanging below root after its tree edge disappeared.
+    void RepairSubtree(int root)
+    {
+        subtree.clear();
+        subtree.push_back(root);
+        invalid[root] = true;
+
+        for (int i = 0; i < (int)subtree.size(); i++)
+        {
+            int vertex = subtree[i];
+
+            for (const Arc& arc : adjacency[vertex])
+            {
+                if (parents[arc.vertex] == vertex && !invalid[arc.vertex])
+                {
+                    invalid[arc.vertex] = true;
+                    subtree.push_back(arc.vertex);
+                }
+            }
+        }
+
+        touchedCount += (int)subtree.size();
+
+        // Breadth-first order puts every tree parent before its children, so a vertex rescued here can
+        // rescue the ones below it in the same pass.
+        for (int vertex : subtree)
+        {
+            for (const Arc& arc : adjacency[vertex])
+            {
+                if (!invalid[arc.vertex] && distances[arc.vertex] != std::numeric_limits<int>::max()
+                    && distances[arc.vertex] + arc.weight == distances[vertex])
+                {
+                    parents[vertex] = arc.vertex;
+                    invalid[vertex] = false;
+                    break;
+                }
+            }
+        }
+
+        for (int vertex : subtree)
+        {
+            if (!invalid[vertex])
+                continue;
+
+            distances[vertex] = std::numeric_limits<int>::max();
+            parents[vertex] = -1;
+        }
+
+        queue.Reset((int)keys.size());
+
+        for (int vertex : subtree)
+        {
+            if (!invalid[vertex])
+                continue;
+
+            for (const Arc& arc : adjacency[vertex])
+                if (!invalid[arc.vertex])
+                    Relax(arc.vertex, vertex, arc.weight);
+        }
+
+        for (int vertex : subtree)
+            invalid[vertex] = false;
+
+        Propagate();
+    }
+
+    // Mirrors the graph and recomputes everything; sourceIndex stays -1 if the source is gone.
+    void Reload()
+    {
+        keys.clear();
+        indexes.clear();
+        adjacency.clear();
+        distances.clear();
+        parents.clear();
+        invalid.clear();
+
+        CsrGraph<TKey> csr = graph.Freeze();
+
+        for (int i = 0; i < csr.GetVertexCount(); i++)
+        {
+            AddSlot(csr.GetVertex(i));
+
+            for (int p = csr.NeighborsBegin(i); p < csr.NeighborsEnd(i); p++)
+                adjacency[i].push_back(Arc{csr.GetNeighbor(p), csr.GetWeight(p)});
+        }
+
+        sourceIndex = FindIndex(source);
+        touchedCount = 0;
+
+        if (sourceIndex == -1)
+            return;
+
+        queue.Reset((int)keys.size());
+        distances[sourceIndex] = 0;
+        queue.Push(sourceIndex, 0);
+        Propagate();
+    }
+
+public:
+
+    // The graph has to outlive this object.
+    DynamicShortestPaths(UndirectedGraph<TKey>& graph, TKey source) : graph(graph), source(source)
+    {
+        Rebuild();
+        graph.Subscribe(this);
+    }
+
+    DynamicShortestPaths(const DynamicShortestPaths&) = delete;
+    DynamicShortestPaths& operator=(const DynamicShortestPaths&) = delete;
+
+    ~DynamicShortestPaths() override
+    {
+        graph.Unsubscribe(this);
+    }
+
+    // Full recomputation from the current graph.
+    void Rebuild()
+    {
+        Reload();
+
+        if (sourceIndex == -1)
+            throw std::invalid_argument("Start vertex not found in the graph.");
+    }
+
+    void OnVertexAdded(const TKey& vertex) override
+    {
+        AddSlot(vertex);
+    }
+
+    // By now every incident edge has been reported, so the vertex is isolated; its slot is kept unused.
+    void OnVertexRemoved(const TKey& vertex) override
+    {
+        int index = FindIndex(vertex);
+
+        if (index != -1)
+        {
+            indexes.erase(vertex);
+            distances[index] = std::numeric_limits<int>::max();
+
+            if (index == sourceIndex)
+                sourceIndex = -1;
+        }
+    }
+
+    void OnGraphReplaced() override
+    {
+        Reload();
+    }
+
+    void OnEdgeAdded(const TKey& vertex1, const TKey& vertex2, int weight) override
+    {
+        int u = FindIndex(vertex1);
+        int v = FindIndex(vertex2);
+        touchedCount = 0;
+
+        adjacency[u].push_back(Arc{v, weight});
+
+        if (u != v)
+            adjacency[v].push_back(Arc{u, weight});
+
+        queue.Reset((int)keys.size());
+        Relax(u, v, weight);
+        Relax(v, u, weight);
+        Propagate();
+    }
+
+    void OnEdgeRemoved(const TKey& vertex1, const TKey& vertex2, int weight) override
+    {
+        int u = FindIndex(vertex1);
+        int v = FindIndex(vertex2);
+        touchedCount = 0;
+
+        auto eraseArc = [&](int from, int to) {
+            std::vector<Arc>& arcs = adjacency[from];
+
+            for (int i = 0; i < (int)arcs.size(); i++)
+            {
+                if (arcs[i].vertex == to)
+                {
+                    arcs[i] = arcs.back();
+                    arcs.pop_back();
+                    break;
+                }
+            }
+        };
+
+        eraseArc(u, v);
+
+        if (u != v)
+            eraseArc(v, u);
+
+        if (parents[v] == u)
+            RepairSubtree(v);
+        else if (parents[u] == v)
+            RepairSubtree(u);
+    }
+
+    TKey GetSource() const
+    {
+        return source;
+    }
+
+    // INT_MAX for unreachable vertices; throws for vertices that are not in the graph.
+    int GetDistance(const TKey& vertex)
+    {
+        int index = FindIndex(vertex);
+
+        if (index == -1)
+            throw std::invalid_argument("Vertex not found in the graph.");
+
+        return distances[index];
+    }
+
+    // Same layout as DiijkstaAlgorithm: one entry per vertex in GetVertex order.
+    DynamicArray<int> GetDistances()
+    {
+        if (sourceIndex == -1)
+            throw std::invalid_argument("Start vertex not found in the graph.");
+
+        DynamicArray<int> result(graph.GetVertexCount());
+
+        for (int i = 0; i < graph.GetVertexCount(); i++)
+            result.Set(i, distances[FindIndex(graph.GetVertex(i))]);
+
+        return result;
+    }
+
+    // Tree path from the source to target, empty if target is unreachable.
+    std::vector<TKey> GetPath(const TKey& target)
+    {
+        int index = FindIndex(target);
+
+        if (index == -1)
+            throw std::invalid_argument("Vertex not found in the graph.");
+
+        std::vector<TKey> path;
+
+        if (distances[index] == std::numeric_limits<int>::max())
+            return path;
+
+        for (int vertex = index; vertex != -1; vertex = parents[vertex])
+            path.push_back(keys[vertex]);
+
+        std::reverse(path.begin(), path.end());
+
+        return path;
+    }
+
+    // Vertices settled or invalidated by the last edge update.
+    int GetTouchedCount() const
+    {
+        return touchedCount;
+    }
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+
+
+class Edge {
+public:
+
+    int vertex;
+    int weight;
+
+    Edge(int v = 0, int w = 0) : vertex(v), weight(w) {}
+
+    bool operator==(const Edge& other) const
+    {
+        return vertex == other.vertex && weight == other.weight;
+    }
+
+    bool operator!=(const Edge& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+
+// Undirected edge with both endpoints, as returned by the MST engines.
+class WeightedEdge {
+public:
+
+    int vertex1;
+    int vertex2;
+    int weight;
+
+    WeightedEdge(int v1 = 0, int v2 = 0, int w = 0) : vertex1(v1), vertex2(v2), weight(w) {}
+
+    bool operator==(const WeightedEdge& other) const
+    {
+        return vertex1 == other.vertex1 && vertex2 == other.vertex2 && weight == other.weight;
+    }
+
+    bool operator!=(const WeightedEdge& other) const
+    {
+        return !(*this == other);
+    }
+};
@@ -0,0 +1,465 @@
+#pragma once
+
+#include <optional>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstdint>
+#include <functional>
+
+#include "idictionary.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+
+// Open-addressing table in the Swiss-table layout: key/value pairs are stored inline in one slot array, and a
+// separate array holds one control byte per slot (empty, deleted, or the low 7 bits of the hash for a full
+// slot). A probe loads a whole group of 16 control bytes and compares them with the hash bits at once (SSE2,
+// a plain loop elsewhere), so most lookups touch one control group and exactly one slot. The capacity is a
+// power of two, so positions are masked instead of taken modulo, and groups are probed triangularly, which
+// visits every group once. The table grows at 7/8 load, counting deleted slots; a grow that finds mostly
+// deleted slots rebuilds at the same capacity instead.
+template <typename TKey, typename TValue, typename Hash = std::hash<TKey>>
+class FlatHashTable : public IDictionary<TKey, TValue>
+{
+private:
+
+    struct Slot {
+        TKey key;
+        TValue value;
+
+        template <typename TKeyArgument, typename... TArgs>
+        Slot(TKeyArgument&& key, TArgs&&... args) : key(std::forward<TKeyArgument>(key)), value(std::forward<TArgs>(args)...) {}
+    };
+
+    static constexpr int groupWidth = 16;
+    static constexpr int minCapacity = 16;
+    static constexpr int8_t emptyControl = -128;
+    static constexpr int8_t deletedControl = -2;
+
+    int8_t* controls = nullptr;
+    Slot* slots = nullptr;
+    int capacity = 0;
+    int size = 0;
+    int growthLeft = 0;
+    Hash hashFunction;
+
+    // std::hash of an integer is the identity, which would leave the 7 control bits nearly constant.
+    static uint64_t Mix(std::size_t hash)
+    {
+        uint64_t mixed = (uint64_t)hash * 0x9E3779B97F4A7C15ULL;
+
+        return mixed ^ (mixed >> 32);
+    }
+
+    static int8_t GetControlBits(uint64_t hash)
+    {
+        return (int8_t)(hash & 0x7F);
+    }
+
+    static int GetMaxLoad(int capacity)
+    {
+        return capacity - capacity / 8;
+    }
+
+    // Bit i is set if control byte i of the group equals value.
+    static uint32_t Match(const int8_t* group, int8_t value)
+    {
+#if defined(__SSE2__)
+        __m128i controlBytes = _mm_loadu_si128((const __m128i*)group);
+
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), controlBytes));
+#else
+        uint32_t bits = 0;
+
+        for (int i = 0; i < groupWidth; i++)
+            if (group[i] == value)
+                bits |= 1u << i;
+
+        return bits;
+#endif
+    }
+
+    // Empty and deleted are the only negative controls below -1.
+    static uint32_t MatchEmptyOrDeleted(const int8_t* group)
+    {
+#if defined(__SSE2__)
+        __m128i controlBytes = _mm_loadu_si128((const __m128i*)group);
+
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), controlBytes));
+#else
+        uint32_t bits = 0;
+
+        for (int i = 0; i < groupWidth; i++)
+            if (group[i] < -1)
+                bits |= 1u << i;
+
+        return bits;
+#endif
+    }
+
+    static int LowestBit(uint32_t bits)
+    {
+        return __builtin_ctz(bits);
+    }
+
+    static int GetCapacityFor(int count)
+    {
+        int result = minCapacity;
+
+        while (GetMaxLoad(result) < count)
+            result *= 2;
+
+        return result;
+    }
+
+    void Allocate(int newCapacity)
+    {
+        capacity = newCapacity;
+        controls = new int8_t[capacity];
+        slots = std::allocator<Slot>().allocate(capacity);
+
+        for (int i = 0; i < capacity; i++)
+            controls[i] = emptyControl;
+
+        growthLeft = GetMaxLoad(capacity) - size;
+    }
+
+    void Release()
+    {
+        if (!controls)
+            return;
+
+        for (int i = 0; i < capacity; i++)
+            if (controls[i] >= 0)
+                slots[i].~Slot();
+
+        std::allocator<Slot>().deallocate(slots, capacity);
+        delete[] controls;
+        controls = nullptr;
+        slots = nullptr;
+        capacity = 0;
+        size = 0;
+        growthLeft = 0;
+    }
+
+    // First empty or deleted slot on the probe sequence of the hash.
+    int FindInsertIndex(uint64_t hash) const
+    {
+        std::size_t groupMask = capacity / groupWidth - 1;
+        std::size_t group = (hash >> 7) & groupMask;
+
+        for (std::size_t step = 1; ; step++)
+        {
+            uint32_t bits = MatchEmptyOrDeleted(controls + group * groupWidth);
+
+            if (bits)
+                return (int)(group * groupWidth) + LowestBit(bits);
+
+            group = (group + step) & groupMask;
+        }
+    }
+
+    // TLookup is TKey, or anything the hash accepts when it is transparent (see StringHash).
+    template <typename TLookup>
+    int FindIndex(const TLookup& key) const
+    {
+        if (size == 0)
+            return -1;
+
+        uint64_t hash = Mix(hashFunction(key));
+        int8_t controlBits = GetControlBits(hash);
+        std::size_t groupMask = capacity / groupWidth - 1;
+        std::size_t group = (hash >> 7) & groupMask;
+
+        for (std::size_t step = 1; ; step++)
+        {
+            const int8_t* groupControls = controls + group * groupWidth;
+
+            for (uint32_t bits = Match(groupControls, controlBits); bits; bits &= bits - 1)
+            {
+                int index = (int)(group * groupWidth) + LowestBit(bits);
+
+                if (slots[index].key == key)
+                    return index;
+            }
+
+            // a probe never passes a group that still has an empty slot
+            if (Match(groupControls, emptyControl))
+                return -1;
+
+            group = (group + step) & groupMask;
+        }
+    }
+
+    void Rehash(int newCapacity)
+    {
+        int8_t* oldControls = controls;
+        Slot* oldSlots = slots;
+        int oldCapacity = capacity;
+
+        Allocate(newCapacity);
+
+        for (int i = 0; i < oldCapacity; i++)
+        {
+            if (oldControls[i] < 0)
+                continue;
+
+            uint64_t hash = Mix(hashFunction(oldSlots[i].key));
+            int index = FindInsertIndex(hash);
+
+            controls[index] = GetControlBits(hash);
+            new (&slots[index]) Slot{std::move(oldSlots[i].key), std::move(oldSlots[i].value)};
+            oldSlots[i].~Slot();
+        }
+
+        std::allocator<Slot>().deallocate(oldSlots, oldCapacity);
+        delete[] oldControls;
+    }
+
+    // Builds a slot for a key known to be absent, in the first free position of its probe sequence.
+    template <typename... TArgs>
+    TValue* InsertSlot(uint64_t hash, TArgs&&... args)
+    {
+        int index = FindInsertIndex(hash);
+
+        if (controls[index] == emptyControl)
+            growthLeft--;
+
+        new (&slots[index]) Slot(std::forward<TArgs>(args)...);
+        controls[index] = GetControlBits(hash);
+        size++;
+
+        return &slots[index].value;
+    }
+
+    void CopyFrom(const FlatHashTable& other)
+    {
+        size = other.size;
+        hashFunction = other.hashFunction;
+        Allocate(other.capacity);
+        growthLeft = other.growthLeft;
+
+        for (int i = 0; i < capacity; i++)
+        {
+            controls[i] = other.controls[i];
+
+            if (controls[i] >= 0)
+                new (&slots[i]) Slot{other.slots[i].key, other.slots[i].value};
+        }
+    }
+
+public:
+
+    FlatHashTable(int capacity = 20)
+    {
+        Allocate(GetCapacityFor(capacity > 0 ? capacity : 20));
+    }
+
+    FlatHashTable(const FlatHashTable& other)
+    {
+        CopyFrom(other);
+    }
+
+    FlatHashTable(FlatHashTable&& other) noexcept
+            : controls(other.controls), slots(other.slots), capacity(other.capacity), size(other.size),
+              growthLeft(other.growthLeft), hashFunction(std::move(other.hashFunction))
+    {
+        other.controls = nullptr;
+        other.slots = nullptr;
+        other.capacity = 0;
+        other.size = 0;
+        other.growthLeft = 0;
+    }
+
+    FlatHashTable& operator=(const FlatHashTable& other)
+    {
+        if (this != &other)
+        {
+            Release();
+            CopyFrom(other);
+        }
+
+        return *this;
+    }
+
+    FlatHashTable& operator=(FlatHashTable&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            std::swap(controls, other.controls);
+            std::swap(slots, other.slots);
+            std::swap(capacity, other.capacity);
+            std::swap(size, other.size);
+            std::swap(growthLeft, other.growthLeft);
+            hashFunction = std::move(other.hashFunction);
+        }
+
+        return *this;
+    }
+
+    ~FlatHashTable() override
+    {
+        Release();
+    }
+
+    void Add(const TKey& key, const TValue& value) override
+    {
+        auto [stored, inserted] = TryEmplace(key, value);
+
+        if (!inserted)
+            *stored = value;
+    }
+
+    // Inserts a value built from args unless the key is present; nothing is built then. Returns the stored
+    // value and whether it was inserted. Slots move when the table grows, so the pointer is only valid until
+    // the next insert or remove.
+    template <typename... TArgs>
+    std::pair<TValue*, bool> TryEmplace(const TKey& key, TArgs&&... args)
+    {
+        // a moved-from table has no slots at all
+        if (capacity == 0)
+            Allocate(minCapacity);
+
+        int index = FindIndex(key);
+
+        if (index != -1)
+            return {&slots[index].value, false};
+
+        uint64_t hash = Mix(hashFunction(key));
+
+        if (growthLeft == 0)
+        {
+            // the arguments may refer to an entry of this table, which the rehash moves and frees
+            Slot slot(key, std::forward<TArgs>(args)...);
+            Rehash(size <= GetMaxLoad(capacity) / 2 ? capacity : capacity * 2);
+
+            return {InsertSlot(hash, std::move(slot)), true};
+        }
+
+        return {InsertSlot(hash, key, std::forward<TArgs>(args)...), true};
+    }
+
+    // Grows the table once so that count entries fit without another resize.
+    void Reserve(int count)
+    {
+        if (capacity == 0 || GetMaxLoad(capacity) < count)
+            Rehash(GetCapacityFor(count));
+    }
+
+    TValue& GetOrInsert(const TKey& key, const TValue& value = TValue()) override
+    {
+        return *TryEmplace(key, value).first;
+    }
+
+    TValue* Find(const TKey& key) override
+    {
+        int index = FindIndex(key);
+
+        return index == -1 ? nullptr : &slots[index].value;
+    }
+
+    const TValue* Find(const TKey& key) const override
+    {
+        int index = FindIndex(key);
+
+        return index == -1 ? nullptr : &slots[index].value;
+    }
+
+    // Heterogeneous lookup, e.g. std::string_view in a FlatHashTable<std::string, TValue, StringHash>.
+    template <typename TLookup> requires requires { typename Hash::is_transparent; }
+    TValue* Find(const TLookup& key)
+    {
+        int index = FindIndex(key);
+
+        return index == -1 ? nullptr : &slots[index].value;
+    }
+
+    template <typename TLookup> requires requires { typename Hash::is_transparent; }
+    const TValue* Find(const TLookup& key) const
+    {
+        int index = FindIndex(key);
+
+        return index == -1 ? nullptr : &slots[index].value;
+    }
+
+    template <typename TLookup> requires requires { typename Hash::is_transparent; }
+    bool ContainsKey(const TLookup& key) const
+    {
+        return FindIndex(key) != -1;
+    }
+
+    bool Remove(const TKey& key) override
+    {
+        int index = FindIndex(key);
+
+        if (index == -1)
+            return false;
+
+        slots[index].~Slot();
+        size--;
+
+        // no probe has continued past a group with an empty slot, so the slot can become empty again
+        if (Match(controls + index / groupWidth * groupWidth, emptyControl))
+        {
+            controls[index] = emptyControl;
+            growthLeft++;
+        }
+        else
+        {
+            controls[index] = deletedControl;
+        }
+
+        return true;
+    }
+
+    std::optional<TValue> GetValue(const TKey& key) const override
+    {
+        int index = FindIndex(key);
+
+        if (index == -1)
+            return std::nullopt;
+
+        return slots[index].value;
+    }
+
+    bool ContainsKey(const TKey& key) const override
+    {
+        return FindIndex(key) != -1;
+    }
+
+    int GetCount() const override
+    {
+        return size;
+    }
+
+    int GetCapacity() const override
+    {
+        return capacity;
+    }
+
+    bool IsEmpty() const
+    {
+        return size == 0;
+    }
+
+    // Slot access in the same shape as HashTable, for iterating over all entries.
+    bool ConstainsIndex(const int index) const
+    {
+        return index >= 0 && index < capacity && controls[index] >= 0;
+    }
+
+    TKey& GetKeyByIndex(const int index) const
+    {
+        return slots[index].key;
+    }
+
+    TValue& GetValueByIndex(const int index) const
+    {
+        return slots[index].value;
+    }
+};
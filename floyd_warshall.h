@@ -0,0 +1,187 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "distance_matrix.h"
+#include "thread_pool.h"
+#include "simd.h"
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+
+
+// Cache-blocked Floyd-Warshall for dense all-pairs distances (Venkataraman et al.).
+// The matrix is cut into blockSize x blockSize tiles. For every diagonal tile k the tile itself is closed first,
+// then the tiles of row k and column k, then all remaining tiles; the tiles of the last two phases are
+// independent and run on the thread pool. The inner min-plus loop c[j] = min(c[j], a + b[j]) uses AVX2 or SSE2.
+//
+// Inside the kernel "no path" is INT_MAX / 2, so a + b can never overflow; paths that long come out as INT_MAX,
+// the same infinity sentinel DiijkstaAlgorithm and PrintGraphDistances use.
+class FloydWarshallEngine {
+private:
+
+    static constexpr int blockSize = 64;
+    static constexpr int kernelInfinity = std::numeric_limits<int>::max() / 2;
+
+    ThreadPool pool;
+    std::vector<int> work;
+    int stride = 0;
+
+    static void MinPlusBlockScalar(int* c, const int* a, const int* b, int stride)
+    {
+        for (int k = 0; k < blockSize; k++)
+        {
+            const int* bRow = b + (size_t)k * stride;
+
+            for (int i = 0; i < blockSize; i++)
+            {
+                int* cRow = c + (size_t)i * stride;
+                int through = a[(size_t)i * stride + k];
+
+                for (int j = 0; j < blockSize; j++)
+                    cRow[j] = std::min(cRow[j], through + bRow[j]);
+            }
+        }
+    }
+
+#ifdef GRAPH_SIMD_X86
+    GRAPH_TARGET_SSE2 static void MinPlusBlockSse2(int* c, const int* a, const int* b, int stride)
+    {
+        for (int k = 0; k < blockSize; k++)
+        {
+            const int* bRow = b + (size_t)k * stride;
+
+            for (int i = 0; i < blockSize; i++)
+            {
+                int* cRow = c + (size_t)i * stride;
+                __m128i through = _mm_set1_epi32(a[(size_t)i * stride + k]);
+
+                for (int j = 0; j < blockSize; j += 4)
+                {
+                    __m128i current = _mm_loadu_si128((const __m128i*)(cRow + j));
+                    __m128i candidate = _mm_add_epi32(through, _mm_loadu_si128((const __m128i*)(bRow + j)));
+                    __m128i greater = _mm_cmpgt_epi32(current, candidate);
+                    __m128i minimum = _mm_or_si128(_mm_and_si128(greater, candidate), _mm_andnot_si128(greater, current));
+                    _mm_storeu_si128((__m128i*)(cRow + j), minimum);
+                }
+            }
+        }
+    }
+
+    GRAPH_TARGET_AVX2 static void MinPlusBlockAvx2(int* c, const int* a, const int* b, int stride)
+    {
+        for (int k = 0; k < blockSize; k++)
+        {
+            const int* bRow = b + (size_t)k * stride;
+
+            for (int i = 0; i < blockSize; i++)
+            {
+                int* cRow = c + (size_t)i * stride;
+                __m256i through = _mm256_set1_epi32(a[(size_t)i * stride + k]);
+
+                for (int j = 0; j < blockSize; j += 8)
+                {
+                    __m256i current = _mm256_loadu_si256((const __m256i*)(cRow + j));
+                    __m256i candidate = _mm256_add_epi32(through, _mm256_loadu_si256((const __m256i*)(bRow + j)));
+                    _mm256_storeu_si256((__m256i*)(cRow + j), _mm256_min_epi32(current, candidate));
+                }
+            }
+        }
+    }
+#endif
+
+    // c = min(c, a (x) b) for the tiles at block coordinates c(i, j), a(i, k), b(k, j).
+    void UpdateBlock(SimdLevel level, int i, int j, int k)
+    {
+        int* base = work.data();
+        int* c = base + ((size_t)i * stride + j) * blockSize;
+        const int* a = base + ((size_t)i * stride + k) * blockSize;
+        const int* b = base + ((size_t)k * stride + j) * blockSize;
+
+#ifdef GRAPH_SIMD_X86
+        if (level == SimdLevel::Avx2)
+            return MinPlusBlockAvx2(c, a, b, stride);
+
+        if (level == SimdLevel::Sse2)
+            return MinPlusBlockSse2(c, a, b, stride);
+#endif
+
+        MinPlusBlockScalar(c, a, b, stride);
+    }
+
+public:
+
+    explicit FloydWarshallEngine(int threadCount = 0) : pool(threadCount) {}
+
+    // Distances between all vertices, rows and columns in the dense vertex order of the graph.
+    // level is clamped to what the CPU supports.
+    template <typename TKey>
+    DistanceMatrix Run(const CsrGraph<TKey>& graph, SimdLevel level = SimdLevel::Avx2)
+    {
+        level = LimitSimdLevel(level);
+
+        int count = graph.GetVertexCount();
+        int blocks = (count + blockSize - 1) / blockSize;
+        stride = blocks * blockSize;
+        work.assign((size_t)stride * stride, kernelInfinity);
+
+        for (int v = 0; v < count; v++)
+        {
+            int* row = work.data() + (size_t)v * stride;
+            row[v] = 0;
+
+            for (int p = graph.NeighborsBegin(v); p < graph.NeighborsEnd(v); p++)
+            {
+                int neighbor = graph.GetNeighbor(p);
+
+                if (neighbor != v)
+                    row[neighbor] = std::min(row[neighbor], std::min(graph.GetWeight(p), kernelInfinity));
+            }
+        }
+
+        for (int k = 0; k < blocks; k++)
+        {
+            UpdateBlock(level, k, k, k);
+
+            pool.ParallelFor(2 * blocks, 1, [&](int thread, int begin, int end) {
+                for (int t = begin; t < end; t++)
+                {
+                    int other = t / 2;
+
+                    if (other == k)
+                        continue;
+
+                    if (t % 2 == 0)
+                        UpdateBlock(level, k, other, k);
+                    else
+                        UpdateBlock(level, other, k, k);
+                }
+            });
+
+            pool.ParallelFor(blocks * blocks, 1, [&](int thread, int begin, int end) {
+                for (int t = begin; t < end; t++)
+                {
+                    int i = t / blocks;
+                    int j = t % blocks;
+
+                    if (i != k && j != k)
+                        UpdateBlock(level, i, j, k);
+                }
+            });
+        }
+
+        DistanceMatrix result(count, count);
+
+        for (int v = 0; v < count; v++)
+        {
+            const int* source = work.data() + (size_t)v * stride;
+            int* target = result.GetRow(v);
+
+            for (int u = 0; u < count; u++)
+                target[u] = source[u] >= kernelInfinity ? std::numeric_limits<int>::max() : source[u];
+        }
+
+        return result;
+    }
+};
@@ -1,192 +1,1717 @@
-#include "functional_tests.h"
-#include "hash_table.h"
-#include "undirected_graph.h"
-#include "dynamic_array.h"
-
-#include <cassert>
-#include <string>
-#include <iostream>
-
-
-
-void TestHashTable()
-{
-
-    HashTable<int, std::string> table(10);
-    assert(table.GetCapacity() == 10);
-    assert(table.GetCount() == 0);
-    assert(table.IsEmpty());
-
-    table.Add(1, "value1");
-    table.Add(2, "value2");
-    table.Add(3, "value3");
-
-    assert(table.GetCount() == 3);
-    assert(!table.IsEmpty());
-    assert(table.ContainsKey(1));
-    assert(table.ContainsKey(2));
-    assert(table.ContainsKey(3));
-    assert(!table.ContainsKey(4));
-
-    assert(table.GetValue(1).has_value() && table.GetValue(1).value() == "value1");
-    assert(table.GetValue(2).has_value() && table.GetValue(2).value() == "value2");
-    assert(table.GetValue(3).has_value() && table.GetValue(3).value() == "value3");
-    assert(!table.GetValue(4).has_value());
-
-    table.Remove(2);
-    assert(!table.ContainsKey(2));
-    assert(table.GetCount() == 2);
-
-    table.Add(2, "new_value2");
-    assert(table.ContainsKey(2));
-    assert(table.GetValue(2).has_value() && table.GetValue(2).value() == "new_value2");
-    assert(table.GetCount() == 3);
-
-    for (int i = 4; i <= 15; ++i)
-    {
-        table.Add(i, "value" + std::to_string(i));
-    }
-
-    assert(table.GetCapacity() >= 20);
-    assert(table.GetCount() == 15);
-
-    for (int i = 1; i <= 15; ++i)
-    {
-        assert(table.ContainsKey(i));
-        assert(table.GetValue(i).has_value());
-    }
-
-    for (int i = 1; i <= 15; ++i)
-    {
-        table.Remove(i);
-    }
-
-    assert(table.IsEmpty());
-    assert(table.GetCapacity() == 20);
-
-    std::cout << "All hash table tests passed!" << std::endl;
-}
-
-void TestUndirectedGraph()
-{
-    UndirectedGraph<int> graph;
-    assert(graph.GetVertexCount() == 0);
-
-    graph.AddVertex(1);
-    graph.AddVertex(2);
-    graph.AddVertex(3);
-
-    assert(graph.GetVertexCount() == 3);
-    assert(graph.GetVertex(0) == 1);
-    assert(graph.GetVertex(1) == 2);
-    assert(graph.GetVertex(2) == 3);
-
-    graph.AddEdge(1, 2, 10);
-    graph.AddEdge(2, 3, 5);
-    graph.AddEdge(1, 3, 15);
-
-    assert(graph.AreConnected(1, 2));
-    assert(graph.AreConnected(2, 3));
-    assert(graph.AreConnected(1, 3));
-    assert(!graph.AreConnected(1, 4));
-
-    auto adj1 = graph.GetAdjacentVertices(1);
-    assert(adj1.GetLength() == 2);
-
-    graph.RemoveEdge(1, 2);
-    assert(!graph.AreConnected(1, 2));
-
-    graph.RemoveVertex(2);
-    assert(graph.GetVertexCount() == 2);
-    assert(!graph.AreConnected(1, 2));
-
-    graph.AddVertex(2);
-    graph.AddEdge(1, 2, 10);
-    graph.AddEdge(2, 3, 5);
-
-    auto distances = graph.DiijkstaAlgorithm(1);
-    int index1 = -1, index2 = -1;
-
-    for (int i = 0; i < graph.GetVertexCount(); ++i)
-    {
-        if (graph.GetVertex(i) == 2) index1 = i;
-        if (graph.GetVertex(i) == 3) index2 = i;
-    }
-
-    assert(index1 != -1 && index2 != -1);
-    assert(distances.GetElement(index1) == 10);
-    assert(distances.GetElement(index2) == 15);
-
-    graph.AddEdge(1, 3, 1);
-    auto mst = graph.FindMinimumSpanningTreeKruskal();
-    assert(mst.GetLength() == 2); // Остов должен содержать V-1 рёбер
-
-    auto colors = graph.ColorGraph();
-    assert(colors.GetLength() == graph.GetVertexCount());
-
-    std::cout << "All undirected graph tests passed!" << std::endl;
-}
-
-void TestDynamicArray()
-{
-    DynamicArray<int> array(5);
-    assert(array.GetLength() == 5);
-
-    for (int i = 0; i < 5; ++i)
-    {
-        array.Set(i, i + 1);
-    }
-
-    assert(array.GetFirstElement() == 1);
-    assert(array.GetLastElement() == 5);
-
-    array.Append(6);
-    assert(array.GetLength() == 6);
-    assert(array.GetLastElement() == 6);
-
-    array.Prepend(0);
-    assert(array.GetLength() == 7);
-    assert(array.GetFirstElement() == 0);
-
-    array.InsertAt(99, 3);
-    assert(array.GetLength() == 8);
-    assert(array.GetElement(3) == 99);
-
-    array.Remove(3);
-    assert(array.GetLength() == 7);
-    assert(array.GetElement(3) != 99);
-
-    auto subsequence = array.GetSubsequence(2, 4);
-    assert(subsequence->GetLength() == 3);
-    assert(subsequence->GetFirstElement() == array.GetElement(2));
-    assert(subsequence->GetLastElement() == array.GetElement(4));
-    delete subsequence;
-
-    DynamicArray<int> array2(3);
-    array2.Set(0, 10);
-    array2.Set(1, 20);
-    array2.Set(2, 30);
-
-    array.Union(&array2);
-    assert(array.GetLength() == 10);
-    assert(array.GetElement(7) == 10);
-    assert(array.GetElement(8) == 20);
-    assert(array.GetElement(9) == 30);
-
-    DynamicArray<int> array3 = array;
-    assert(array3 == array);
-
-    DynamicArray<int> array4(array);
-    assert(array4 == array);
-
-    std::cout << "All dynamic array tests passed!" << std::endl;
-}
-
-void RunFunctionalTests()
-{
-    TestDynamicArray();
-    TestHashTable();
-    TestUndirectedGraph();
-
-    std::cout << "\n";
+#include "functional_tests.h"
+#include "hash_table.h"
+#include "flat_hash_table.h"
+#include "undirected_graph.h"
+#include "dynamic_array.h"
+#include "graph_creator.h"
+#include "priority_queues.h"
+#include "shortest_path.h"
+#include "alt_query.h"
+#include "contraction_hierarchies.h"
+#include "delta_stepping.h"
+#include "batch_distances.h"
+#include "floyd_warshall.h"
+#include "dense_dijkstra.h"
+#include "distance_cache.h"
+#include "dynamic_shortest_paths.h"
+#include "minimum_spanning_tree.h"
+#include "dynamic_minimum_spanning_tree.h"
+#include "graph_coloring.h"
+#include "dynamic_coloring.h"
+#include "vertex_interner.h"
+#include "concurrent_hash_table.h"
+#include "concurrent_edge_builder.h"
+#include "thread_pool.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <span>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <atomic>
+#include <stdexcept>
+
+
+
+// Find, TryEmplace, GetOrInsert and string_view lookup, shared by both hash tables.
+template <template <typename, typename, typename> class TTable>
+void CheckInPlaceAccess()
+{
+    TTable<std::string, DynamicArray<int>, StringHash> table;
+    IDictionary<std::string, DynamicArray<int>>& dictionary = table;
+
+    auto [values, inserted] = table.TryEmplace("a", 0, 3);
+    assert(inserted && values->GetLength() == 3);
+    values->Set(0, 7);
+
+    auto [existing, insertedAgain] = table.TryEmplace("a", 5);
+    assert(!insertedAgain && existing->GetLength() == 3 && (*existing)[0] == 7);
+
+    std::string_view name = "abc";
+    assert(table.Find(name.substr(0, 1)) != nullptr && (*table.Find(name.substr(0, 1)))[0] == 7);
+    assert(table.Find(name) == nullptr && !table.ContainsKey(name));
+    assert(table.Find("a") == existing && table.ContainsKey("a") && !table.ContainsKey("abc"));
+
+    dictionary.GetOrInsert("b").Append(4);
+    dictionary.GetOrInsert("b").Append(5);
+    assert(dictionary.Find("b")->GetLength() == 2 && (*dictionary.Find("b"))[1] == 5);
+
+    const IDictionary<std::string, DynamicArray<int>>& constant = table;
+    assert(constant.Find("c") == nullptr && constant.GetCount() == 2);
+
+    TTable<int, int, std::hash<int>> counters;
+
+    for (int i = 0; i < 1000; i++)
+        counters.GetOrInsert(i % 10)++;
+
+    assert(counters.GetCount() == 10 && *counters.Find(3) == 100);
+
+    // values that refer to an entry of the same table, inserted across several resizes
+    TTable<int, std::string, std::hash<int>> copies;
+    std::string first(40, 'x');
+    copies.Add(0, first);
+
+    for (int i = 1; i < 300; i++)
+    {
+        if (i % 3 == 0)
+            copies.Add(i, *copies.Find(0));
+        else if (i % 3 == 1)
+            copies.GetOrInsert(i, *copies.Find(i - 1));
+        else
+            copies.TryEmplace(i, *copies.Find(i / 2));
+    }
+
+    for (int i = 0; i < 300; i++)
+        assert(*copies.Find(i) == first);
+}
+
+void TestHashTable()
+{
+
+    HashTable<int, std::string> table(10);
+    assert(table.GetCapacity() == 10);
+    assert(table.GetCount() == 0);
+    assert(table.IsEmpty());
+
+    table.Add(1, "value1");
+    table.Add(2, "value2");
+    table.Add(3, "value3");
+
+    assert(table.GetCount() == 3);
+    assert(!table.IsEmpty());
+    assert(table.ContainsKey(1));
+    assert(table.ContainsKey(2));
+    assert(table.ContainsKey(3));
+    assert(!table.ContainsKey(4));
+
+    assert(table.GetValue(1).has_value() && table.GetValue(1).value() == "value1");
+    assert(table.GetValue(2).has_value() && table.GetValue(2).value() == "value2");
+    assert(table.GetValue(3).has_value() && table.GetValue(3).value() == "value3");
+    assert(!table.GetValue(4).has_value());
+
+    assert(table.Remove(2) && !table.Remove(2));
+    assert(!table.ContainsKey(2));
+    assert(table.GetCount() == 2);
+
+    table.Add(2, "new_value2");
+    assert(table.ContainsKey(2));
+    assert(table.GetValue(2).has_value() && table.GetValue(2).value() == "new_value2");
+    assert(table.GetCount() == 3);
+
+    for (int i = 4; i <= 15; ++i)
+    {
+        table.Add(i, "value" + std::to_string(i));
+    }
+
+    assert(table.GetCapacity() >= 20);
+    assert(table.GetCount() == 15);
+
+    for (int i = 1; i <= 15; ++i)
+    {
+        assert(table.ContainsKey(i));
+        assert(table.GetValue(i).has_value());
+    }
+
+    for (int i = 1; i <= 15; ++i)
+    {
+        table.Remove(i);
+    }
+
+    assert(table.IsEmpty());
+    assert(table.GetCapacity() == 20);
+
+    // removals keep every remaining key reachable and the probe bookkeeping exact
+    HashTable<int, int> numbers;
+    std::unordered_map<int, int> expected;
+    std::mt19937 gen(9);
+    std::uniform_int_distribution<> keyDis(0, 3000);
+
+    for (int i = 0; i < 50000; i++)
+    {
+        int key = keyDis(gen);
+
+        if (gen() % 2 == 0)
+        {
+            numbers.Remove(key);
+            expected.erase(key);
+        }
+        else
+        {
+            numbers.Add(key, i);
+            expected[key] = i;
+        }
+    }
+
+    assert(numbers.GetCount() == (int)expected.size());
+
+    for (int key = 0; key <= 3000; key++)
+        assert(numbers.GetValue(key) == (expected.count(key) ? std::optional<int>(expected[key]) : std::nullopt));
+
+    ProbeStatistics statistics = numbers.GetProbeStatistics();
+    int counted = 0;
+
+    for (int length = 0; length < (int)statistics.histogram.size(); length++)
+        counted += statistics.histogram[length];
+
+    assert(counted == numbers.GetCount());
+    assert(statistics.maxLength == (int)statistics.histogram.size() - 1);
+
+    // alternating around a resize point resizes once, not on every call
+    HashTable<int, int> boundary;
+
+    for (int i = 0; i < 14; i++)
+        boundary.Add(i, i);
+
+    int resizes = boundary.GetResizeCount();
+
+    for (int i = 0; i < 100; i++)
+    {
+        boundary.Add(100, 0);
+        boundary.Remove(100);
+    }
+
+    assert(boundary.GetResizeCount() == resizes + 1);
+
+    CheckInPlaceAccess<HashTable>();
+
+    std::cout << "All hash table tests passed!" << std::endl;
+}
+
+void TestFlatHashTable()
+{
+    FlatHashTable<int, std::string> table(10);
+    assert(table.GetCapacity() == 16);
+    assert(table.IsEmpty());
+
+    table.Add(1, "value1");
+    table.Add(2, "value2");
+    table.Add(1, "new_value1");
+    assert(table.GetCount() == 2);
+    assert(table.GetValue(1).value() == "new_value1");
+    assert(!table.GetValue(3).has_value());
+
+    assert(table.Remove(2));
+    assert(!table.Remove(2));
+    assert(!table.ContainsKey(2) && table.GetCount() == 1);
+
+    FlatHashTable<int, int> reserved;
+    reserved.Reserve(1000);
+    int reservedCapacity = reserved.GetCapacity();
+
+    for (int i = 0; i < 1000; i++)
+        reserved.Add(i, i);
+
+    assert(reserved.GetCapacity() == reservedCapacity && reserved.GetCount() == 1000);
+
+    // random inserts and removes against std::unordered_map, with enough churn to leave deleted slots behind
+    FlatHashTable<int, int> numbers;
+    std::unordered_map<int, int> expected;
+    std::mt19937 gen(5);
+    std::uniform_int_distribution<> keyDis(0, 5000);
+
+    for (int i = 0; i < 100000; i++)
+    {
+        int key = keyDis(gen);
+
+        if (gen() % 3 == 0)
+        {
+            numbers.Remove(key);
+            expected.erase(key);
+        }
+        else
+        {
+            numbers.Add(key, i);
+            expected[key] = i;
+        }
+    }
+
+    assert(numbers.GetCount() == (int)expected.size());
+
+    for (int key = 0; key <= 5000; key++)
+    {
+        auto it = expected.find(key);
+        std::optional<int> value = numbers.GetValue(key);
+        assert(value.has_value() == (it != expected.end()));
+        assert(!value.has_value() || value.value() == it->second);
+    }
+
+    int visited = 0;
+
+    for (int index = 0; index < numbers.GetCapacity(); index++)
+        if (numbers.ConstainsIndex(index))
+            visited++;
+
+    assert(visited == numbers.GetCount());
+
+    FlatHashTable<int, int> copy = numbers;
+    FlatHashTable<int, int> moved = std::move(numbers);
+    assert(copy.GetCount() == moved.GetCount() && numbers.GetCount() == 0);
+    numbers.Add(7, 7);
+    assert(numbers.GetValue(7).value() == 7);
+
+    IDictionary<std::string, int>* dictionary = new FlatHashTable<std::string, int>();
+    dictionary->Add("a", 1);
+    assert(dictionary->ContainsKey("a") && !dictionary->ContainsKey("b"));
+    delete dictionary;
+
+    CheckInPlaceAccess<FlatHashTable>();
+
+    std::cout << "All flat hash table tests passed!" << std::endl;
+}
+
+void TestUndirectedGraph()
+{
+    UndirectedGraph<int> graph;
+    assert(graph.GetVertexCount() == 0);
+
+    graph.AddVertex(1);
+    graph.AddVertex(2);
+    graph.AddVertex(3);
+
+    assert(graph.GetVertexCount() == 3);
+    assert(graph.GetVertex(0) == 1);
+    assert(graph.GetVertex(1) == 2);
+    assert(graph.GetVertex(2) == 3);
+
+    graph.AddEdge(1, 2, 10);
+    graph.AddEdge(2, 3, 5);
+    graph.AddEdge(1, 3, 15);
+
+    assert(graph.AreConnected(1, 2));
+    assert(graph.AreConnected(2, 3));
+    assert(graph.AreConnected(1, 3));
+    assert(!graph.AreConnected(1, 4));
+
+    auto adj1 = graph.GetAdjacentVertices(1);
+    assert(adj1.GetLength() == 2);
+
+    NeighborRange<int> neighbors = graph.Neighbors(1);
+    assert(neighbors.GetLength() == 2);
+    assert(neighbors[0].vertex == 2 && neighbors[0].weight == 10);
+    assert(neighbors[1].vertex == 3 && neighbors[1].weight == 15);
+    assert(neighbors[1].id == graph.GetVertexId(3));
+
+    int weightSum = 0;
+
+    for (Neighbor<int> neighbor : graph.Neighbors(2))
+        weightSum += neighbor.weight;
+
+    assert(weightSum == 15);
+    assert(graph.Neighbors(4).IsEmpty());
+
+    graph.RemoveEdge(1, 2);
+    assert(!graph.AreConnected(1, 2));
+
+    graph.RemoveVertex(2);
+    assert(graph.GetVertexCount() == 2);
+    assert(!graph.AreConnected(1, 2));
+
+    graph.AddVertex(2);
+    graph.AddEdge(1, 2, 10);
+    graph.AddEdge(2, 3, 5);
+
+    auto distances = graph.DiijkstaAlgorithm(1);
+    int index1 = -1, index2 = -1;
+
+    for (int i = 0; i < graph.GetVertexCount(); ++i)
+    {
+        if (graph.GetVertex(i) == 2) index1 = i;
+        if (graph.GetVertex(i) == 3) index2 = i;
+    }
+
+    assert(index1 != -1 && index2 != -1);
+    assert(distances.GetElement(index1) == 10);
+    assert(distances.GetElement(index2) == 15);
+
+    graph.AddEdge(1, 3, 1);
+    auto mst = graph.FindMinimumSpanningTreeKruskal();
+    assert(mst.GetLength() == 2); // Остов должен содержать V-1 рёбер
+
+    auto colors = graph.ColorGraph();
+    assert(colors.GetLength() == graph.GetVertexCount());
+
+    std::cout << "All undirected graph tests passed!" << std::endl;
+}
+
+struct CountedConstruction {
+    static inline int constructions = 0;
+
+    CountedConstruction() { constructions++; }
+};
+
+// Counts live objects; the copy constructor throws once copiesLeft runs out.
+struct ThrowingCopy {
+    static inline int live = 0;
+    static inline int copiesLeft = -1;
+
+    ThrowingCopy() { live++; }
+
+    ThrowingCopy(const ThrowingCopy&)
+    {
+        if (copiesLeft-- == 0)
+            throw std::runtime_error("copy failed");
+
+        live++;
+    }
+
+    ~ThrowingCopy() { live--; }
+};
+
+void TestDynamicArray()
+{
+    DynamicArray<int> array(5);
+    assert(array.GetLength() == 5);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        array.Set(i, i + 1);
+    }
+
+    assert(array.GetFirstElement() == 1);
+    assert(array.GetLastElement() == 5);
+
+    array.Append(6);
+    assert(array.GetLength() == 6);
+    assert(array.GetLastElement() == 6);
+
+    array.Prepend(0);
+    assert(array.GetLength() == 7);
+    assert(array.GetFirstElement() == 0);
+
+    array.InsertAt(99, 3);
+    assert(array.GetLength() == 8);
+    assert(array.GetElement(3) == 99);
+
+    array.Remove(3);
+    assert(array.GetLength() == 7);
+    assert(array.GetElement(3) != 99);
+
+    auto subsequence = array.GetSubsequence(2, 4);
+    assert(subsequence->GetLength() == 3);
+    assert(subsequence->GetFirstElement() == array.GetElement(2));
+    assert(subsequence->GetLastElement() == array.GetElement(4));
+    delete subsequence;
+
+    DynamicArray<int> array2(3);
+    array2.Set(0, 10);
+    array2.Set(1, 20);
+    array2.Set(2, 30);
+
+    array.Union(&array2);
+    assert(array.GetLength() == 10);
+    assert(array.GetElement(7) == 10);
+    assert(array.GetElement(8) == 20);
+    assert(array.GetElement(9) == 30);
+
+    DynamicArray<int> array3 = array;
+    assert(array3 == array);
+
+    DynamicArray<int> array4(array);
+    assert(array4 == array);
+
+    // geometric growth: a million appends reallocate a few dozen times, not a million
+    DynamicArray<int> grown;
+    int reallocations = 0;
+
+    for (int i = 0; i < 1000000; i++)
+    {
+        int capacity = grown.GetCapacity();
+        grown.Append(i);
+
+        if (grown.GetCapacity() != capacity)
+            reallocations++;
+    }
+
+    assert(grown.GetLength() == 1000000 && grown[999999] == 999999);
+    assert(reallocations < 40);
+
+    grown.Remove(0);
+    assert(grown[0] == 1 && grown.GetCapacity() >= 1000000);
+    grown.ShrinkToFit();
+    assert(grown.GetCapacity() == grown.GetLength());
+
+    DynamicArray<int> moved = std::move(grown);
+    assert(moved.GetLength() == 999999 && grown.GetLength() == 0);
+    grown = std::move(moved);
+    assert(grown.GetLength() == 999999 && grown[0] == 1);
+
+    // appending an element of the array itself while it reallocates
+    DynamicArray<std::string> words;
+    words.Reserve(2);
+    words.EmplaceBack(3, 'a');
+    words.EmplaceBack("b");
+    assert(words.GetCapacity() == 2);
+    words.EmplaceBack(words[0]);
+    words.Append(words[1]);
+    words.InsertAt(words[2], 1);
+    assert(words.GetLength() == 5 && words[1] == "aaa" && words[4] == "b");
+
+    // spare slots are raw memory, so reserving constructs nothing
+    DynamicArray<CountedConstruction> counted(2);
+    counted.Reserve(100);
+    counted.EmplaceBack();
+    assert(CountedConstruction::constructions == 3);
+
+    // a copy that throws while the buffer is reused must not leave destroyed elements behind
+    {
+        DynamicArray<ThrowingCopy> target(4);
+        DynamicArray<ThrowingCopy> source(2);
+        ThrowingCopy::copiesLeft = 1;
+        bool thrown = false;
+
+        try
+        {
+            target = source;
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+
+        assert(thrown && target.GetLength() == 0 && ThrowingCopy::live == 2);
+        ThrowingCopy::copiesLeft = -1;
+    }
+
+    assert(ThrowingCopy::live == 0);
+
+    std::cout << "All dynamic array tests passed!" << std::endl;
+}
+
+void TestCsrGraph()
+{
+    UndirectedGraph<int> graph = GenerateGraph(40, 120, 1, 20);
+    CsrGraph<int> csr = graph.Freeze();
+
+    assert(csr.GetVertexCount() == graph.GetVertexCount());
+    assert(csr.GetEdgeCount() == 120);
+
+    for (int i = 0; i < csr.GetVertexCount(); ++i)
+    {
+        assert(csr.GetVertex(i) == graph.GetVertex(i));
+        assert(csr.GetIndex(graph.GetVertex(i)) == i);
+        assert(csr.GetDegree(i) == graph.GetAdjacentVertices(graph.GetVertex(i)).GetLength());
+    }
+
+    assert(csr.GetIndex(1000) == -1);
+
+    assert(csr.DiijkstaAlgorithm(0) == graph.DiijkstaAlgorithm(0));
+    assert(csr.ColorGraph() == graph.ColorGraph());
+    assert(csr.FindMinimumSpanningTreeKruskal() == graph.FindMinimumSpanningTreeKruskal());
+
+    UndirectedGraph<int> empty;
+    assert(empty.Freeze().GetVertexCount() == 0);
+    assert(empty.Freeze().FindMinimumSpanningTreeKruskal().GetLength() == 0);
+
+    std::cout << "All CSR graph tests passed!" << std::endl;
+}
+
+template <typename TQueue>
+void CheckPriorityQueue()
+{
+    TQueue queue;
+    const int count = 200;
+
+    for (int run = 0; run < 2; ++run)
+    {
+        queue.Reset(count);
+        std::vector<int> keys(count, -1);
+
+        for (int i = 0; i < 600; ++i)
+        {
+            int vertex = rand() % count;
+            int key = rand() % 1000;
+
+            if (keys[vertex] == -1 || key < keys[vertex])
+                keys[vertex] = key;
+
+            queue.Push(vertex, key);
+        }
+
+        int previous = -1;
+
+        while (!queue.IsEmpty())
+        {
+            int vertex;
+            int key;
+            queue.PopMin(vertex, key);
+
+            assert(key >= previous);
+            assert(keys[vertex] == key);
+            assert(!queue.Contains(vertex));
+
+            keys[vertex] = -1;
+            previous = key;
+        }
+
+        for (int i = 0; i < count; ++i)
+            assert(keys[i] == -1);
+
+        queue.Reset(count);
+        queue.Push(3, 10);
+        queue.Push(5, 4);
+        assert(queue.Contains(3));
+    }
+}
+
+void TestHeapDijkstra()
+{
+    CheckPriorityQueue<BinaryHeap>();
+    CheckPriorityQueue<QuaternaryHeap>();
+    CheckPriorityQueue<PairingHeap>();
+
+    UndirectedGraph<int> graph = GenerateGraph(60, 150, 1, 30);
+    graph.AddVertex(100);
+
+    DynamicArray<int> expected = graph.DiijkstaAlgorithm(0);
+
+    assert(graph.HeapDiijkstaAlgorithm<BinaryHeap>(0) == expected);
+    assert(graph.HeapDiijkstaAlgorithm<QuaternaryHeap>(0) == expected);
+    assert(graph.HeapDiijkstaAlgorithm<PairingHeap>(0) == expected);
+    assert(expected.GetElement(60) == std::numeric_limits<int>::max());
+
+    // the cached snapshot follows mutations, and a copy keeps its own
+    UndirectedGraph<int> copy = graph;
+    assert(copy.HeapDiijkstaAlgorithm<BinaryHeap>(0) == expected);
+
+    graph.AddEdge(0, 100, 7);
+    assert(graph.HeapDiijkstaAlgorithm<BinaryHeap>(0).GetElement(60) == 7);
+    assert(graph.HeapDiijkstaAlgorithm<PairingHeap>(0) == graph.DiijkstaAlgorithm(0));
+    assert(copy.HeapDiijkstaAlgorithm<BinaryHeap>(0) == expected);
+
+    graph.RemoveEdge(0, 100);
+    assert(graph.HeapDiijkstaAlgorithm<QuaternaryHeap>(0) == expected);
+
+    std::cout << "All heap Dijkstra tests passed!" << std::endl;
+}
+
+void TestShortestPath()
+{
+    UndirectedGraph<int> graph = GenerateGraph(80, 200, 1, 25);
+    graph.AddVertex(500);
+    CsrGraph<int> csr = graph.Freeze();
+    ShortestPathQuery<int> query(csr);
+
+    for (int source = 0; source < 80; source += 7)
+    {
+        DynamicArray<int> distances = graph.DiijkstaAlgorithm(source);
+
+        for (int target = 0; target < 80; target += 3)
+        {
+            const ShortestPathResult<int>& result = query.ShortestPath(source, target);
+            assert(result.distance == distances.GetElement(csr.GetIndex(target)));
+
+            if (result.distance == std::numeric_limits<int>::max())
+            {
+                assert(result.path.empty());
+                continue;
+            }
+
+            assert(result.path.front() == source);
+            assert(result.path.back() == target);
+
+            int length = 0;
+
+            for (int i = 0; i + 1 < (int)result.path.size(); ++i)
+            {
+                int u = csr.GetIndex(result.path[i]);
+                int weight = -1;
+
+                for (int p = csr.NeighborsBegin(u); p < csr.NeighborsEnd(u); ++p)
+                    if (csr.GetVertex(csr.GetNeighbor(p)) == result.path[i + 1])
+                        weight = csr.GetWeight(p);
+
+                assert(weight != -1);
+                length += weight;
+            }
+
+            assert(length == result.distance);
+        }
+    }
+
+    assert(query.ShortestPath(3, 3).distance == 0);
+    assert(query.ShortestPath(3, 3).path.size() == 1);
+    assert(query.ShortestPath(0, 500).distance == std::numeric_limits<int>::max());
+    assert(query.ShortestPath(0, 500).path.empty());
+
+    std::cout << "All shortest path tests passed!" << std::endl;
+}
+
+void TestAltQuery()
+{
+    UndirectedGraph<int> graph = GenerateGraph(100, 250, 1, 40);
+    graph.AddVertex(1000);
+    CsrGraph<int> csr = graph.Freeze();
+    LandmarkIndex index(csr, 6);
+    AltQuery<> query(csr, index);
+
+    assert(index.GetLandmarkCount() == 6);
+
+    for (int source = 0; source < 100; source += 9)
+    {
+        DynamicArray<int> distances = graph.DiijkstaAlgorithm(source);
+
+        for (int target = 0; target < 100; target += 4)
+        {
+            const ShortestPathResult<int>& result = query.ShortestPath(source, target);
+            assert(result.distance == distances.GetElement(csr.GetIndex(target)));
+
+            if (result.distance != std::numeric_limits<int>::max())
+            {
+                assert(result.path.front() == source);
+                assert(result.path.back() == target);
+            }
+        }
+
+        assert(query.ShortestPath(source, 1000).distance == std::numeric_limits<int>::max());
+    }
+
+    std::string filename = "alt_test_tables.txt";
+    index.Save(filename, csr);
+
+    CsrGraph<int> loadedGraph;
+    LandmarkIndex loadedIndex;
+    assert(LandmarkIndex::Load(filename, loadedGraph, loadedIndex));
+    std::remove(filename.c_str());
+
+    assert(loadedGraph.GetVertexCount() == csr.GetVertexCount());
+    assert(loadedGraph.GetEdgeCount() == csr.GetEdgeCount());
+    assert(loadedIndex.GetLandmarkCount() == index.GetLandmarkCount());
+
+    AltQuery<> loadedQuery(loadedGraph, loadedIndex);
+
+    for (int target = 0; target < 100; target += 11)
+        assert(loadedQuery.ShortestPath(5, target).distance == query.ShortestPath(5, target).distance);
+
+    // a self-loop is a single adjacency entry, which the saved entry count has to account for
+    UndirectedGraph<int> looped = GenerateGraph(30, 60, 1, 20);
+    looped.AddEdge(3, 3, 7);
+    CsrGraph<int> loopedCsr = looped.Freeze();
+    LandmarkIndex loopedIndex(loopedCsr, 3);
+    loopedIndex.Save(filename, loopedCsr);
+
+    assert(LandmarkIndex::Load(filename, loadedGraph, loadedIndex));
+    assert(loadedGraph.NeighborsEnd(loadedGraph.GetVertexCount() - 1) == loopedCsr.NeighborsEnd(loopedCsr.GetVertexCount() - 1));
+
+    AltQuery<> loopedQuery(loopedCsr, loopedIndex);
+    AltQuery<> loadedLoopedQuery(loadedGraph, loadedIndex);
+
+    for (int target = 0; target < 30; target += 3)
+        assert(loadedLoopedQuery.ShortestPath(3, target).distance == loopedQuery.ShortestPath(3, target).distance);
+
+    // corrupt files: a neighbor out of range with the right total count, a negative degree, a truncated file,
+    // a landmark out of range, a negative distance, negative weights, a repeated vertex key, a repeated landmark,
+    // and a landmark that is not at distance 0 from itself
+    const char* corruptFiles[] = {
+        "2 2 1\n10 1\n20 1\n1 5\n7 5\n0\n0 5\n5 0\n",
+        "2 2 1\n10 -1\n20 3\n1 5\n0 5\n0\n0 5\n5 0\n",
+        "2 2 1\n10 1\n20",
+        "2 2 1\n10 1\n20 1\n1 5\n0 5\n9\n0 5\n5 0\n",
+        "2 2 1\n10 1\n20 1\n1 5\n0 5\n0\n0 -5\n",
+        "2 2 1\n10 1\n20 1\n1 -5\n0 -5\n0\n0 5\n",
+        "2 2 1\n10 1\n10 1\n1 5\n0 5\n0\n0 5\n5 0\n",
+        "2 2 2\n10 1\n20 1\n1 5\n0 5\n0 0\n0 0\n5 5\n",
+        "2 2 1\n10 1\n20 1\n1 5\n0 5\n0\n3 5\n5 0\n",
+    };
+
+    for (const char* contents : corruptFiles)
+    {
+        {
+            std::ofstream file(filename);
+            file << contents;
+        }
+
+        assert(!LandmarkIndex::Load(filename, loadedGraph, loadedIndex));
+    }
+
+    {
+        std::ofstream file(filename);
+        file << "2 2 1\n10 1\n20 1\n1 5\n0 5\n0\n0 5\n5 0\n";
+    }
+
+    assert(LandmarkIndex::Load(filename, loadedGraph, loadedIndex));
+    assert(loadedGraph.GetEdgeCount() == 1);
+    std::remove(filename.c_str());
+
+    std::cout << "All ALT query tests passed!" << std::endl;
+}
+
+void TestContractionHierarchies()
+{
+    for (int attempt = 0; attempt < 3; ++attempt)
+    {
+        UndirectedGraph<int> graph = GenerateGraph(120, 120 + attempt * 150, 1, 50);
+        graph.AddVertex(1000);
+        CsrGraph<int> csr = graph.Freeze();
+
+        int lastProgress = 0;
+        ContractionHierarchy<int> hierarchy(csr, 1 + attempt, [&](int contracted, int total) {
+            assert(contracted > lastProgress && total == csr.GetVertexCount());
+            lastProgress = contracted;
+        });
+        ContractionHierarchyQuery<int> query(hierarchy);
+
+        assert(lastProgress == csr.GetVertexCount());
+
+        for (int source = 0; source < 120; source += 13)
+        {
+            DynamicArray<int> distances = graph.DiijkstaAlgorithm(source);
+
+            for (int i = 0; i < csr.GetVertexCount(); ++i)
+                assert(query.Distance(source, csr.GetVertex(i)) == distances.GetElement(i));
+        }
+    }
+
+    std::cout << "All contraction hierarchies tests passed!" << std::endl;
+}
+
+void TestDeltaStepping()
+{
+    UndirectedGraph<int> graph = GenerateGraph(150, 600, 1, 60);
+    graph.AddVertex(1000);
+    CsrGraph<int> csr = graph.Freeze();
+
+    assert(DeltaSteppingEngine::ChooseDelta(csr) >= 1);
+
+    for (int threads = 1; threads <= 4; threads *= 2)
+    {
+        DeltaSteppingEngine engine(threads);
+
+        for (int delta : {0, 1, 7, 100})
+        {
+            for (int source = 0; source < 150; source += 37)
+            {
+                DynamicArray<int> expected = graph.DiijkstaAlgorithm(source);
+                const std::vector<int>& distances = engine.Run(csr, csr.GetIndex(source), delta);
+
+                for (int i = 0; i < csr.GetVertexCount(); ++i)
+                    assert(distances[i] == expected.GetElement(i));
+            }
+        }
+    }
+
+    // one heavy edge with a tiny delta must not blow the bucket ring up to weight / delta entries
+    graph.AddEdge(1000, 3, 1000000000);
+    CsrGraph<int> heavy = graph.Freeze();
+    DeltaSteppingEngine engine(2);
+    DynamicArray<int> expected = graph.DiijkstaAlgorithm(1000);
+    const std::vector<int>& distances = engine.Run(heavy, heavy.GetIndex(1000), 1);
+
+    assert(engine.GetBucketCount() <= heavy.GetVertexCount() + 2);
+
+    for (int i = 0; i < heavy.GetVertexCount(); ++i)
+        assert(distances[i] == expected.GetElement(i));
+
+    std::cout << "All delta-stepping tests passed!" << std::endl;
+}
+
+void TestBatchDistances()
+{
+    UndirectedGraph<int> graph = GenerateGraph(70, 180, 1, 30);
+    graph.AddVertex(1000);
+    CsrGraph<int> csr = graph.Freeze();
+    BatchDistanceEngine<> engine(3, 4);
+    std::vector<int> sources = {5, 0, 1000, 33, 5, 69, 12, 40, 2, 18};
+
+    DistanceMatrix matrix = engine.ComputeDistances(csr, sources);
+    assert(matrix.GetRowCount() == (int)sources.size());
+    assert(matrix.GetColumnCount() == csr.GetVertexCount());
+
+    for (int row = 0; row < (int)sources.size(); ++row)
+    {
+        DynamicArray<int> expected = graph.DiijkstaAlgorithm(sources[row]);
+
+        for (int column = 0; column < csr.GetVertexCount(); ++column)
+            assert(matrix.Get(row, column) == expected.GetElement(column));
+    }
+
+    int rowsSeen = 0;
+    engine.ForEachAllPairsTile(csr, [&](int firstRow, const DistanceMatrix& tile) {
+        assert(firstRow == rowsSeen);
+        assert(tile.GetRowCount() <= engine.GetTileRows());
+
+        for (int row = 0; row < tile.GetRowCount(); ++row)
+            for (int column = 0; column < tile.GetColumnCount(); ++column)
+                if (column == firstRow + row)
+                    assert(tile.Get(row, column) == 0);
+
+        rowsSeen += tile.GetRowCount();
+    });
+    assert(rowsSeen == csr.GetVertexCount());
+
+    bool thrown = false;
+    try
+    {
+        engine.ComputeDistances(csr, std::vector<int>{-5});
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+
+    std::cout << "All batch distance tests passed!" << std::endl;
+}
+
+void TestFloydWarshall()
+{
+    UndirectedGraph<int> graph = GenerateGraph(90, 1500, 1, 100);
+    graph.AddVertex(1000);
+    graph.AddVertex(1001);
+    graph.AddEdge(1000, 1001, 7);
+    CsrGraph<int> csr = graph.Freeze();
+    FloydWarshallEngine engine(2);
+
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2})
+    {
+        DistanceMatrix matrix = engine.Run(csr, level);
+        assert(matrix.GetRowCount() == csr.GetVertexCount());
+
+        for (int row = 0; row < csr.GetVertexCount(); row += 5)
+        {
+            DynamicArray<int> expected = graph.DiijkstaAlgorithm(csr.GetVertex(row));
+
+            for (int column = 0; column < csr.GetVertexCount(); ++column)
+                assert(matrix.Get(row, column) == expected.GetElement(column));
+        }
+
+        assert(matrix.Get(csr.GetIndex(1000), csr.GetIndex(1001)) == 7);
+        assert(matrix.Get(csr.GetIndex(1000), 0) == std::numeric_limits<int>::max());
+    }
+
+    UndirectedGraph<int> empty;
+    assert(engine.Run(empty.Freeze()).GetRowCount() == 0);
+
+    std::cout << "All Floyd-Warshall tests passed!" << std::endl;
+}
+
+void TestDenseDijkstra()
+{
+    UndirectedGraph<int> graph = GenerateGraph(77, 1200, 1, 90);
+    graph.AddVertex(1000);
+    CsrGraph<int> csr = graph.Freeze();
+    DenseDijkstraEngine dense;
+    AdaptiveDijkstraEngine adaptive;
+
+    for (int source = 0; source < 77; source += 19)
+    {
+        DynamicArray<int> expected = graph.DiijkstaAlgorithm(source);
+
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::Sse2, SimdLevel::Avx2})
+        {
+            const std::vector<int>& distances = dense.Run(csr, source, level);
+
+            for (int i = 0; i < csr.GetVertexCount(); ++i)
+                assert(distances[i] == expected.GetElement(i));
+        }
+
+        for (DijkstraMode mode : {DijkstraMode::Auto, DijkstraMode::Dense, DijkstraMode::Heap})
+        {
+            const std::vector<int>& distances = adaptive.Run(csr, source, mode);
+
+            for (int i = 0; i < csr.GetVertexCount(); ++i)
+                assert(distances[i] == expected.GetElement(i));
+        }
+    }
+
+    assert(AdaptiveDijkstraEngine::ChooseMode(100000, 300000) == DijkstraMode::Heap);
+    assert(AdaptiveDijkstraEngine::ChooseMode(2000, 1500000) == DijkstraMode::Dense);
+
+    std::cout << "All dense Dijkstra tests passed!" << std::endl;
+}
+
+void TestDistanceCache()
+{
+    UndirectedGraph<int> graph;
+    unsigned long long version = graph.GetVersion();
+
+    graph.AddVertex(1);
+    graph.AddVertex(2);
+    graph.AddVertex(3);
+    assert(graph.GetVersion() > version);
+
+    version = graph.GetVersion();
+    graph.AddVertex(2);
+    graph.AddEdge(1, 7, 4);
+    assert(graph.GetVersion() == version);
+
+    graph.AddEdge(1, 2, 4);
+    assert(graph.GetVersion() > version);
+
+    version = graph.GetVersion();
+    graph.RemoveEdge(1, 3);
+    graph.RemoveEdge(2, 9);
+    assert(graph.GetVersion() == version);
+
+    UndirectedGraph<int> other;
+    assert(other.GetVersion() != graph.GetVersion());
+
+    DistanceCache<int> cache(2 * DistanceCache<int>::GetEntryBytes(3));
+
+    assert(cache.GetDistances(graph, 1) == graph.DiijkstaAlgorithm(1));
+    assert(cache.GetDistances(graph, 1) == graph.DiijkstaAlgorithm(1));
+    assert(cache.GetHitCount() == 1 && cache.GetMissCount() == 1);
+
+    graph.AddEdge(2, 3, 6);
+    DynamicArray<int> distances = cache.GetDistances(graph, 1);
+    assert(distances == graph.DiijkstaAlgorithm(1));
+    assert(distances.GetElement(2) == 10);
+    assert(cache.GetMissCount() == 2);
+
+    cache.GetDistances(graph, 2);
+    cache.GetDistances(graph, 3);
+    assert(cache.GetEvictionCount() > 0);
+    assert(cache.GetUsedBytes() <= cache.GetBudget());
+
+    cache.GetDistances(graph, 3);
+    assert(cache.GetHitCount() == 2);
+
+    cache.SetBudget(0);
+    assert(cache.GetCount() == 0);
+    assert(cache.GetDistances(graph, 3) == graph.DiijkstaAlgorithm(3));
+
+    std::cout << "All distance cache tests passed!" << std::endl;
+}
+
+void TestVertexInterner()
+{
+    VertexInterner<std::string> interner;
+
+    uint32_t a = interner.Intern("a");
+    uint32_t b = interner.Intern("b");
+    assert(a == 0 && b == 1);
+    assert(interner.Intern("a") == a);
+    assert(interner.Find("c") == VertexInterner<std::string>::invalidId);
+    assert(interner.GetKey(b) == "b");
+
+    assert(interner.Release("a") == a);
+    assert(!interner.IsAlive(a) && interner.GetGeneration(a) == 1);
+    assert(interner.Release("a") == VertexInterner<std::string>::invalidId);
+
+    uint32_t c = interner.Intern("c");
+    assert(c == a && interner.IsAlive(c));
+    assert(interner.GetCapacity() == 2 && interner.GetCount() == 2);
+
+    UndirectedGraph<int> graph;
+
+    for (int i = 0; i < 5; i++)
+        graph.AddVertex(i * 10);
+
+    graph.AddEdge(0, 10, 1);
+    graph.AddEdge(10, 20, 2);
+    graph.AddEdge(20, 30, 3);
+    graph.AddEdge(30, 40, 4);
+
+    uint32_t removedId = graph.GetVertexId(20);
+    graph.RemoveVertex(20);
+    assert(graph.GetVertexId(20) == VertexInterner<int>::invalidId);
+    assert(graph.GetVertex(2) == 30 && graph.GetVertex(3) == 40);
+    assert(!graph.AreConnected(10, 20) && !graph.AreConnected(30, 20));
+
+    // churn keeps the id range at the peak vertex count
+    for (int round = 0; round < 100; round++)
+    {
+        graph.AddVertex(100 + round);
+        graph.AddEdge(100 + round, 0, round);
+        graph.RemoveVertex(100 + round);
+    }
+
+    assert(graph.GetIdCapacity() == 5);
+    assert(graph.GetVertexGeneration(removedId) == 101);
+
+    graph.AddVertex(50);
+    assert(graph.GetVertexId(50) == removedId);
+    assert(graph.GetVertexById(removedId) == 50);
+    assert(graph.GetVertex(4) == 50);
+
+    graph.AddEdge(50, 0, 7);
+    DynamicArray<Edge> edges = graph.GetAdjacentVertices(0);
+    assert(edges.GetLength() == 2 && edges[0].vertex == 10 && edges[1].vertex == 50);
+
+    DynamicArray<int> distances = graph.DiijkstaAlgorithm(0);
+    assert(distances == graph.HeapDiijkstaAlgorithm(0));
+    assert(distances[0] == 0 && distances[1] == 1 && distances[4] == 7);
+    assert(distances[2] == std::numeric_limits<int>::max());
+
+    std::cout << "All vertex interner tests passed!" << std::endl;
+}
+
+
+// WeightedEdge endpoints are ints, so the bulk loader only exists for keys built from one.
+template <typename TGraph>
+concept BulkLoadable = requires(TGraph& graph, std::span<const WeightedEdge> edges) { graph.BuildFromEdges(edges); };
+
+void TestBuildFromEdges()
+{
+    std::vector<WeightedEdge> edges = {
+            WeightedEdge(1, 2, 4), WeightedEdge(2, 3, 1), WeightedEdge(3, 1, 7),
+            WeightedEdge(2, 1, 9), WeightedEdge(3, 3, 2), WeightedEdge(4, 5, 3), WeightedEdge(1, 2, 8)
+    };
+
+    static_assert(BulkLoadable<UndirectedGraph<int>> && !BulkLoadable<UndirectedGraph<std::string>>);
+
+    UndirectedGraph<int> bulk;
+    UndirectedGraph<int> incremental;
+    bulk.AddVertex(9);
+    bulk.AddVertex(1);
+    bulk.AddEdge(9, 1, 5);
+
+    DynamicShortestPaths<int> paths(bulk, 9);
+    unsigned long long version = bulk.GetVersion();
+    bulk.BuildFromEdges(edges, 2);
+    assert(bulk.GetVersion() > version);
+
+    incremental.AddVertex(9);
+    incremental.AddVertex(1);
+    incremental.AddEdge(9, 1, 5);
+
+    for (const WeightedEdge& edge : edges)
+    {
+        incremental.AddVertex(edge.vertex1);
+        incremental.AddVertex(edge.vertex2);
+        incremental.AddEdge(edge.vertex1, edge.vertex2, edge.weight);
+    }
+
+    assert(bulk.GetVertexCount() == 6);
+
+    for (int i = 0; i < incremental.GetVertexCount(); i++)
+    {
+        int vertex = incremental.GetVertex(i);
+        assert(bulk.GetVertex(i) == vertex);
+        assert(bulk.Neighbors(vertex).GetLength() == incremental.Neighbors(vertex).GetLength());
+
+        for (Neighbor<int> neighbor : incremental.Neighbors(vertex))
+            assert(bulk.AreConnected(vertex, neighbor.vertex));
+    }
+
+    assert(bulk.Neighbors(1)[0].vertex == 9);
+    assert(bulk.DiijkstaAlgorithm(1) == incremental.DiijkstaAlgorithm(1));
+    assert(paths.GetDistance(3) == 10);
+
+    // one thread and many threads give the same lists
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<> vertexDis(0, 499);
+    std::vector<WeightedEdge> random(20000);
+
+    for (WeightedEdge& edge : random)
+        edge = WeightedEdge(vertexDis(gen), vertexDis(gen), vertexDis(gen) + 1);
+
+    UndirectedGraph<int> sequential;
+    UndirectedGraph<int> parallel;
+    sequential.BuildFromEdges(random, 1);
+    parallel.BuildFromEdges(random, 4);
+
+    CsrGraph<int> csr1 = sequential.Freeze();
+    CsrGraph<int> csr2 = parallel.Freeze();
+    assert(csr1.GetVertexCount() == csr2.GetVertexCount() && csr1.GetEdgeCount() == csr2.GetEdgeCount());
+
+    for (int p = 0; p < csr1.NeighborsEnd(csr1.GetVertexCount() - 1); p++)
+        assert(csr1.GetNeighbor(p) == csr2.GetNeighbor(p) && csr1.GetWeight(p) == csr2.GetWeight(p));
+
+    std::cout << "All bulk load tests passed!" << std::endl;
+}
+
+
+void TestConcurrentHashTable()
+{
+    ConcurrentHashTable<int, int> table(20, 8);
+    ThreadPool pool(4);
+    assert(table.GetShardCount() == 8);
+
+    // every thread counts the same keys and adds keys of its own
+    pool.Run([&](int thread) {
+        for (int i = 0; i < 20000; i++)
+        {
+            table.AddOrUpdate(i % 100, [](int& value) { value++; });
+            table.Add(1000 + thread * 20000 + i, i);
+        }
+    });
+
+    assert(table.GetCount() == 100 + pool.GetThreadCount() * 20000);
+
+    for (int key = 0; key < 100; key++)
+        assert(table.GetValue(key).value() == pool.GetThreadCount() * 200);
+
+    pool.Run([&](int thread) {
+        for (int i = 0; i < 20000; i++)
+            assert(table.Remove(1000 + thread * 20000 + i));
+    });
+
+    assert(table.GetCount() == 100 && !table.ContainsKey(1000) && !table.Remove(1000));
+    assert(!table.TryEmplace(5, 0) && table.TryEmplace(-5, 3));
+
+    int seen = 0;
+    table.Visit(-5, [&](const int& value) { seen = value; });
+    assert(seen == 3);
+
+    // concurrent ingestion gives the same graph as a sequential one
+    std::mt19937 gen(21);
+    std::uniform_int_distribution<> vertexDis(0, 299);
+    std::vector<WeightedEdge> edges(6000);
+
+    // no self-loops, which CsrGraph::GetEdgeCount would count as half an edge
+    for (WeightedEdge& edge : edges)
+    {
+        do
+            edge = WeightedEdge(vertexDis(gen), vertexDis(gen), vertexDis(gen) + 1);
+        while (edge.vertex1 == edge.vertex2);
+    }
+
+    ConcurrentEdgeBuilder builder;
+    std::atomic<int> next(0);
+
+    // claiming edges one by one from a shared counter interleaves the threads on duplicate edges
+    pool.Run([&](int thread) {
+        for (int i = next++; i < (int)edges.size(); i = next++)
+            builder.AddEdge(edges[i].vertex1, edges[i].vertex2, edges[i].weight);
+    });
+
+    UndirectedGraph<int> parallel;
+    UndirectedGraph<int> sequential;
+    builder.BuildGraph(parallel);
+    sequential.BuildFromEdges(edges);
+
+    assert(builder.GetEdgeCount() == (long long)edges.size());
+    assert(builder.GetVertexCount() == sequential.GetVertexCount());
+    assert(parallel.GetVertexCount() == sequential.GetVertexCount());
+    assert(parallel.Freeze().GetEdgeCount() == sequential.Freeze().GetEdgeCount());
+
+    for (int i = 0; i < sequential.GetVertexCount(); i++)
+    {
+        int vertex = sequential.GetVertex(i);
+
+        for (Neighbor<int> neighbor : sequential.Neighbors(vertex))
+        {
+            bool found = false;
+
+            // the weight of a repeated edge depends on which thread got there first, so only symmetry is checked
+            for (Neighbor<int> other : parallel.Neighbors(neighbor.vertex))
+                found = found || other.vertex == vertex;
+
+            assert(found && parallel.AreConnected(vertex, neighbor.vertex));
+        }
+    }
+
+    // from one thread: both endpoints counted, ascending vertex order, the first weight of a repeated edge, a
+    // stored self-loop
+    ConcurrentEdgeBuilder small;
+    small.AddEdge(5, 2, 4);
+    assert(small.GetVertexCount() == 2);
+    small.AddEdge(2, 5, 9);
+    small.AddEdge(7, 7, 1);
+    small.AddVertex(1);
+    assert(small.GetVertexCount() == 4 && small.GetEdgeCount() == 3);
+
+    UndirectedGraph<int> built;
+    small.BuildGraph(built, 1);
+    assert(built.GetVertexCount() == 4);
+    assert(built.GetVertex(0) == 1 && built.GetVertex(1) == 2 && built.GetVertex(2) == 5 && built.GetVertex(3) == 7);
+    assert(built.Neighbors(2).GetLength() == 1 && built.Neighbors(2)[0].weight == 4);
+    assert(built.Neighbors(5)[0].weight == 4 && built.AreConnected(7, 7));
+
+    std::cout << "All concurrent hash table tests passed!" << std::endl;
+}
+
+
+void TestDynamicShortestPaths()
+{
+    UndirectedGraph<int> graph = GenerateGraph(60, 150, 0, 9);
+    DynamicShortestPaths<int> paths(graph, 0);
+    std::mt19937 gen(2024);
+    std::uniform_int_distribution<> vertexDis(0, 59);
+    std::uniform_int_distribution<> weightDis(0, 9);
+
+    assert(paths.GetDistances() == graph.DiijkstaAlgorithm(0));
+
+    for (int step = 0; step < 400; ++step)
+    {
+        int vertex1 = vertexDis(gen);
+        int vertex2 = vertexDis(gen);
+
+        if (vertex1 == vertex2)
+            continue;
+
+        if (graph.AreConnected(vertex1, vertex2))
+            graph.RemoveEdge(vertex1, vertex2);
+        else
+            graph.AddEdge(vertex1, vertex2, weightDis(gen));
+
+        assert(paths.GetDistances() == graph.DiijkstaAlgorithm(0));
+    }
+
+    DynamicArray<int> distances = graph.DiijkstaAlgorithm(0);
+
+    for (int target = 0; target < 60; ++target)
+    {
+        std::vector<int> path = paths.GetPath(target);
+
+        if (distances.GetElement(target) == std::numeric_limits<int>::max())
+        {
+            assert(path.empty());
+            continue;
+        }
+
+        assert(path.front() == 0 && path.back() == target);
+
+        int length = 0;
+
+        for (int i = 0; i + 1 < (int)path.size(); ++i)
+        {
+            DynamicArray<Edge> edges = graph.GetAdjacentVertices(path[i]);
+            bool found = false;
+
+            for (int j = 0; j < edges.GetLength(); ++j)
+            {
+                if (edges[j].vertex == path[i + 1])
+                {
+                    length += edges[j].weight;
+                    found = true;
+                }
+            }
+
+            assert(found);
+        }
+
+        assert(length == distances.GetElement(target));
+    }
+
+    graph.AddVertex(100);
+    assert(paths.GetDistance(100) == std::numeric_limits<int>::max());
+    graph.AddEdge(0, 100, 3);
+    assert(paths.GetDistance(100) == 3);
+
+    graph.RemoveVertex(7);
+    assert(paths.GetDistances() == graph.DiijkstaAlgorithm(0));
+
+    bool thrown = false;
+
+    try
+    {
+        paths.GetDistance(7);
+    }
+    catch (const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+
+    assert(thrown);
+
+    graph = GenerateGraph(30, 60, 1, 20);
+    assert(paths.GetDistances() == graph.DiijkstaAlgorithm(0));
+
+    std::cout << "All dynamic shortest path tests passed!" << std::endl;
+}
+
+long long GetTotalWeight(const DynamicArray<Edge>& edges)
+{
+    long long total = 0;
+
+    for (int i = 0; i < edges.GetLength(); ++i)
+        total += edges[i].weight;
+
+    return total;
+}
+
+void TestMinimumSpanningTreeEngine()
+{
+    DisjointSet set(5);
+    assert(set.Union(0, 1) && set.Union(3, 4) && !set.Union(1, 0));
+    assert(set.Connected(0, 1) && !set.Connected(1, 3));
+    assert(set.GetSetCount() == 3);
+
+    UndirectedGraph<int> graph = GenerateGraph(300, 1500, 1, 60);
+    graph.AddVertex(1000);
+    graph.AddVertex(1001);
+    graph.AddEdge(1000, 1001, -4);
+    graph.AddEdge(0, 1000, 250000);
+    graph.AddEdge(1, 1001, 70000);
+
+    CsrGraph<int> csr = graph.Freeze();
+    DynamicArray<Edge> expected = graph.FindMinimumSpanningTreeKruskal();
+    MinimumSpanningTreeEngine single(1);
+    MinimumSpanningTreeEngine parallel(4);
+    UndirectedGraph<int> empty;
+
+    for (MstAlgorithm algorithm : {MstAlgorithm::Kruskal, MstAlgorithm::FilterKruskal, MstAlgorithm::Boruvka})
+    {
+        std::vector<WeightedEdge> forest = single.Run(csr, algorithm);
+
+        assert(forest == parallel.Run(csr, algorithm));
+        assert((int)forest.size() == expected.GetLength());
+        assert(GetTotalWeight(forest) == GetTotalWeight(expected));
+
+        DisjointSet components(csr.GetVertexCount());
+
+        for (const WeightedEdge& edge : forest)
+        {
+            assert(components.Union(edge.vertex1, edge.vertex2));
+
+            DynamicArray<Edge> adjacent = graph.GetAdjacentVertices(csr.GetVertex(edge.vertex1));
+            bool found = false;
+
+            for (int i = 0; i < adjacent.GetLength(); ++i)
+                if (adjacent[i].vertex == csr.GetVertex(edge.vertex2) && adjacent[i].weight == edge.weight)
+                    found = true;
+
+            assert(found);
+        }
+
+        assert(single.Run(empty.Freeze(), algorithm).empty());
+    }
+
+    UndirectedGraph<int> large = GenerateGraph(3000, 60000, 1, 100000);
+    CsrGraph<int> largeCsr = large.Freeze();
+    long long largeWeight = GetTotalWeight(parallel.Run(largeCsr, MstAlgorithm::Kruskal));
+
+    for (MstAlgorithm algorithm : {MstAlgorithm::FilterKruskal, MstAlgorithm::Boruvka})
+    {
+        assert(GetTotalWeight(single.Run(largeCsr, algorithm)) == largeWeight);
+        assert(GetTotalWeight(parallel.Run(largeCsr, algorithm)) == largeWeight);
+        assert((int)parallel.GetThreadCount() == 4);
+    }
+
+    // endpoints are CSR indices, so keys that are not ints work as well
+    UndirectedGraph<std::string> named;
+    named.AddVertex("a");
+    named.AddVertex("b");
+    named.AddVertex("c");
+    named.AddEdge("a", "b", 3);
+    named.AddEdge("b", "c", 1);
+    named.AddEdge("a", "c", 2);
+    CsrGraph<std::string> namedCsr = named.Freeze();
+
+    for (MstAlgorithm algorithm : {MstAlgorithm::Kruskal, MstAlgorithm::FilterKruskal, MstAlgorithm::Boruvka})
+    {
+        const std::vector<WeightedEdge>& forest = single.Run(namedCsr, algorithm);
+        assert(forest.size() == 2 && GetTotalWeight(forest) == 3);
+
+        for (const WeightedEdge& edge : forest)
+            assert(named.AreConnected(namedCsr.GetVertex(edge.vertex1), namedCsr.GetVertex(edge.vertex2)));
+    }
+
+    std::cout << "All minimum spanning tree engine tests passed!" << std::endl;
+}
+
+void TestDynamicMinimumSpanningTree()
+{
+    UndirectedGraph<int> graph = GenerateGraph(80, 60, 1, 40);
+    DynamicMinimumSpanningTree<int> mst(graph, 1);
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<> vertexDis(0, 79);
+    std::uniform_int_distribution<> weightDis(1, 40);
+
+    assert(mst.GetTotalWeight() == GetTotalWeight(graph.FindMinimumSpanningTreeKruskal()));
+
+    for (int step = 0; step < 500; ++step)
+    {
+        int vertex1 = vertexDis(gen);
+        int vertex2 = vertexDis(gen);
+
+        if (vertex1 == vertex2 || graph.AreConnected(vertex1, vertex2))
+            continue;
+
+        graph.AddEdge(vertex1, vertex2, weightDis(gen));
+
+        DynamicArray<Edge> expected = graph.FindMinimumSpanningTreeKruskal();
+        assert(mst.GetEdgeCount() == expected.GetLength());
+        assert(mst.GetTotalWeight() == GetTotalWeight(expected));
+    }
+
+    assert(mst.GetRebuildCount() == 1);
+
+    std::vector<WeightedEdge> edges = mst.GetEdges();
+    DisjointSet components(100);
+
+    for (const WeightedEdge& edge : edges)
+    {
+        assert(components.Union(edge.vertex1, edge.vertex2));
+        assert(graph.AreConnected(edge.vertex1, edge.vertex2));
+    }
+
+    for (int vertex = 1; vertex < 80; ++vertex)
+    {
+        if (graph.AreConnected(0, vertex) && !mst.ContainsEdge(0, vertex))
+        {
+            graph.RemoveEdge(0, vertex);
+            assert(mst.GetTotalWeight() == GetTotalWeight(graph.FindMinimumSpanningTreeKruskal()));
+            assert(mst.GetRebuildCount() == 1);
+            break;
+        }
+    }
+
+    graph.RemoveEdge(edges[0].vertex1, edges[0].vertex2);
+    graph.AddEdge(edges[0].vertex1, edges[0].vertex2, 1000);
+    assert(mst.GetTotalWeight() == GetTotalWeight(graph.FindMinimumSpanningTreeKruskal()));
+    assert(mst.GetRebuildCount() == 2);
+
+    graph.RemoveVertex(5);
+    graph.AddVertex(200);
+    graph.AddEdge(200, 6, 3);
+    assert(mst.GetTotalWeight() == GetTotalWeight(graph.FindMinimumSpanningTreeKruskal()));
+    assert(mst.ContainsEdge(6, 200));
+
+    graph = GenerateGraph(30, 100, 1, 20);
+    assert(mst.GetTotalWeight() == GetTotalWeight(graph.FindMinimumSpanningTreeKruskal()));
+
+    std::cout << "All dynamic minimum spanning tree tests passed!" << std::endl;
+}
+
+bool IsProperColoring(const CsrGraph<int>& graph, const std::vector<int>& colors)
+{
+    for (int v = 0; v < graph.GetVertexCount(); ++v)
+    {
+        if (colors[v] < 0)
+            return false;
+
+        for (int p = graph.NeighborsBegin(v); p < graph.NeighborsEnd(v); ++p)
+            if (graph.GetNeighbor(p) != v && colors[graph.GetNeighbor(p)] == colors[v])
+                return false;
+    }
+
+    return true;
+}
+
+void TestGraphColoring()
+{
+    UndirectedGraph<int> graph = GenerateGraph(150, 1200, 1, 10);
+    graph.AddVertex(1000);
+    CsrGraph<int> csr = graph.Freeze();
+    ColoringEngine engine;
+    int maxDegree = 0;
+
+    for (int v = 0; v < csr.GetVertexCount(); ++v)
+        maxDegree = std::max(maxDegree, csr.GetDegree(v));
+
+    assert(graph.ColorGraph() == csr.ColorGraph());
+
+    for (ColoringOrder order : {ColoringOrder::Natural, ColoringOrder::LargestFirst, ColoringOrder::SmallestLast, ColoringOrder::Dsatur})
+    {
+        const std::vector<int>& colors = engine.Run(csr, order);
+
+        assert(IsProperColoring(csr, colors));
+        assert(engine.GetColorCount() <= maxDegree + 1);
+        assert(*std::max_element(colors.begin(), colors.end()) == engine.GetColorCount() - 1);
+
+        DynamicArray<int> fromGraph = graph.ColorGraph(order);
+
+        for (int v = 0; v < csr.GetVertexCount(); ++v)
+            assert(fromGraph[v] == colors[v]);
+    }
+
+    // a grid is bipartite and 2-degenerate
+    UndirectedGraph<int> grid;
+
+    for (int i = 0; i < 100; ++i)
+        grid.AddVertex(i);
+
+    for (int row = 0; row < 10; ++row)
+    {
+        for (int column = 0; column < 10; ++column)
+        {
+            if (column + 1 < 10)
+                grid.AddEdge(row * 10 + column, row * 10 + column + 1, 1);
+
+            if (row + 1 < 10)
+                grid.AddEdge(row * 10 + column, row * 10 + column + 10, 1);
+        }
+    }
+
+    CsrGraph<int> gridCsr = grid.Freeze();
+
+    engine.Run(gridCsr, ColoringOrder::Dsatur);
+    assert(engine.GetColorCount() == 2);
+
+    engine.Run(gridCsr, ColoringOrder::SmallestLast);
+    assert(engine.GetColorCount() <= 3);
+
+    UndirectedGraph<int> empty;
+    assert(engine.Run(empty.Freeze(), ColoringOrder::Dsatur).empty());
+    assert(engine.GetColorCount() == 0);
+
+    std::cout << "All graph coloring tests passed!" << std::endl;
+}
+
+void TestParallelColoring()
+{
+    UndirectedGraph<int> graph = GenerateGraph(2000, 30000, 1, 10);
+    CsrGraph<int> csr = graph.Freeze();
+    ParallelColoringEngine single(1);
+    ParallelColoringEngine parallel(4);
+
+    std::vector<int> colors = single.Run(csr, ParallelColoringMode::JonesPlassmann, 42);
+    assert(IsProperColoring(csr, colors));
+    assert(single.GetConflictCount() == 0);
+    assert(single.GetRoundCount() > 1);
+    assert(parallel.Run(csr, ParallelColoringMode::JonesPlassmann, 42) == colors);
+    assert(parallel.GetColorCount() == single.GetColorCount());
+    assert(parallel.GetRoundCount() == single.GetRoundCount());
+
+    DynamicArray<int> natural = graph.ColorGraph();
+    const std::vector<int>& sequential = single.Run(csr, ParallelColoringMode::Speculative);
+    assert(single.GetConflictCount() == 0 && single.GetRoundCount() == 1);
+
+    for (int v = 0; v < csr.GetVertexCount(); ++v)
+        assert(sequential[v] == natural[v]);
+
+    assert(IsProperColoring(csr, parallel.Run(csr, ParallelColoringMode::Speculative)));
+    assert(parallel.GetColorCount() >= 1);
+
+    UndirectedGraph<int> empty;
+    assert(parallel.Run(empty.Freeze()).empty());
+    assert(parallel.GetColorCount() == 0);
+
+    std::cout << "All parallel coloring tests passed!" << std::endl;
+}
+
+void CheckDynamicColoring(UndirectedGraph<int>& graph, DynamicColoring<int>& coloring)
+{
+    CsrGraph<int> csr = graph.Freeze();
+    DynamicArray<int> colors = coloring.GetColors();
+    std::vector<int> dense(csr.GetVertexCount());
+    int highest = -1;
+
+    for (int i = 0; i < csr.GetVertexCount(); ++i)
+    {
+        dense[i] = colors[i];
+        highest = std::max(highest, colors[i]);
+        assert(coloring.GetColor(csr.GetVertex(i)) == colors[i]);
+    }
+
+    assert(IsProperColoring(csr, dense));
+    assert(coloring.GetPaletteSize() == highest + 1);
+}
+
+void TestDynamicColoring()
+{
+    for (bool kempe : {false, true})
+    {
+        UndirectedGraph<int> graph = GenerateGraph(120, 200, 1, 10);
+        DynamicColoring<int> coloring(graph, kempe);
+        std::mt19937 gen(11);
+        std::uniform_int_distribution<> vertexDis(0, 119);
+
+        CheckDynamicColoring(graph, coloring);
+
+        for (int step = 0; step < 1500; ++step)
+        {
+            int vertex1 = vertexDis(gen);
+            int vertex2 = vertexDis(gen);
+
+            if (vertex1 == vertex2)
+                continue;
+
+            if (step % 5 == 4 && graph.AreConnected(vertex1, vertex2))
+                graph.RemoveEdge(vertex1, vertex2);
+            else
+                graph.AddEdge(vertex1, vertex2, 1);
+
+            if (step % 50 == 0)
+                CheckDynamicColoring(graph, coloring);
+        }
+
+        CheckDynamicColoring(graph, coloring);
+        assert(coloring.GetRecolorCount() > 0);
+        assert(kempe || coloring.GetKempeSwapCount() == 0);
+
+        graph.RemoveVertex(3);
+        graph.AddVertex(500);
+        graph.AddEdge(500, 4, 1);
+        graph.AddEdge(500, 5, 1);
+        CheckDynamicColoring(graph, coloring);
+
+        graph = GenerateGraph(40, 200, 1, 5);
+        CheckDynamicColoring(graph, coloring);
+    }
+
+    // paths 0-1-2-3 and 4-5 colored 0,1,0,1 and 0,1; joining 3 and 5 keeps two colors only through a Kempe swap
+    UndirectedGraph<int> path;
+
+    for (int i = 0; i < 6; ++i)
+        path.AddVertex(i);
+
+    path.AddEdge(0, 1, 1);
+    path.AddEdge(1, 2, 1);
+    path.AddEdge(2, 3, 1);
+    path.AddEdge(4, 5, 1);
+
+    DynamicColoring<int> coloring(path, true, 64, ColoringOrder::Natural);
+    path.AddEdge(3, 5, 1);
+    CheckDynamicColoring(path, coloring);
+    assert(coloring.GetPaletteSize() == 2);
+    assert(coloring.GetKempeSwapCount() == 1);
+
+    // a self-loop present at Rebuild does not count towards the degree, just as when it is added afterwards,
+    // so of two isolated endpoints the first one is recolored either way
+    for (bool loopFirst : {true, false})
+    {
+        UndirectedGraph<int> looped;
+        looped.AddVertex(0);
+        looped.AddVertex(1);
+
+        if (loopFirst)
+            looped.AddEdge(0, 0, 1);
+
+        DynamicColoring<int> loopedColoring(looped, false, 64, ColoringOrder::Natural);
+
+        if (!loopFirst)
+            looped.AddEdge(0, 0, 1);
+
+        looped.AddEdge(0, 1, 1);
+        assert(loopedColoring.GetColor(0) == 1 && loopedColoring.GetColor(1) == 0);
+    }
+
+    std::cout << "All dynamic coloring tests passed!" << std::endl;
+}
+
+void RunFunctionalTests()
+{
+    TestDynamicArray();
+    TestHashTable();
+    TestFlatHashTable();
+    TestUndirectedGraph();
+    TestCsrGraph();
+    TestHeapDijkstra();
+    TestShortestPath();
+    TestAltQuery();
+    TestContractionHierarchies();
+    TestDeltaStepping();
+    TestBatchDistances();
+    TestFloydWarshall();
+    TestDenseDijkstra();
+    TestDistanceCache();
+    TestVertexInterner();
+    TestBuildFromEdges();
+    TestConcurrentHashTable();
+    TestDynamicShortestPaths();
+    TestMinimumSpanningTreeEngine();
+    TestDynamicMinimumSpanningTree();
+    TestGraphColoring();
+    TestParallelColoring();
+    TestDynamicColoring();
+
+    std::cout << "\n";
 }
\ No newline at end of file
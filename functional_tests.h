@@ -1,4 +1,4 @@
-#pragma once
-
-
+#pragma once
+
+
 void RunFunctionalTests();
\ No newline at end of file
@@ -0,0 +1,529 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "thread_pool.h"
+
+#include <vector>
+#include <unordered_set>
+#include <atomic>
+#include <algorithm>
+
+
+
+enum class ColoringOrder {
+    Natural,            // dense vertex order, the same result as ColorGraph
+    LargestFirst,       // Welsh-Powell: decreasing degree
+    SmallestLast,       // Matula-Beck: repeatedly peel a vertex of smallest remaining degree, color in reverse
+    Dsatur              // Brelaz: next vertex is the one with the most distinct neighbor colors
+};
+
+
+// Intrusive doubly linked lists of vertices, one per bucket; insert, remove and move are O(1).
+class VertexBuckets {
+private:
+
+    std::vector<int> heads;
+    std::vector<int> next;
+    std::vector<int> previous;
+    std::vector<int> buckets;
+
+public:
+
+    void Reset(int vertexCount, int bucketCount)
+    {
+        heads.assign(bucketCount, -1);
+        next.assign(vertexCount, -1);
+        previous.assign(vertexCount, -1);
+        buckets.assign(vertexCount, -1);
+    }
+
+    void Insert(int vertex, int bucket)
+    {
+        buckets[vertex] = bucket;
+        previous[vertex] = -1;
+        next[vertex] = heads[bucket];
+
+        if (heads[bucket] != -1)
+            previous[heads[bucket]] = vertex;
+
+        heads[bucket] = vertex;
+    }
+
+    void Remove(int vertex)
+    {
+        if (previous[vertex] != -1)
+            next[previous[vertex]] = next[vertex];
+        else
+            heads[buckets[vertex]] = next[vertex];
+
+        if (next[vertex] != -1)
+            previous[next[vertex]] = previous[vertex];
+
+        buckets[vertex] = -1;
+    }
+
+    void Move(int vertex, int bucket)
+    {
+        Remove(vertex);
+        Insert(vertex, bucket);
+    }
+
+    // -1 if the bucket is empty.
+    int GetFirst(int bucket) const
+    {
+        return heads[bucket];
+    }
+
+    // -1 once the vertex has been removed.
+    int GetBucket(int vertex) const
+    {
+        return buckets[vertex];
+    }
+};
+
+
+// Greedy coloring in O(V + E) over dense ids: every vertex takes the smallest color not used by an already
+// colored neighbor, found with a "last seen" stamp per color instead of a fresh boolean array. The orders only
+// change which vertex goes next; orderings are built with counting sort or bucket queues, so they stay linear
+// too (DSATUR additionally remembers which (vertex, color) pairs it has already counted).
+// Colors are 0-based and indexed by dense id, the layout PrintGraphColor and SaveColoredGraphToDot expect.
+class ColoringEngine {
+private:
+
+    std::vector<int> colors;
+    std::vector<int> order;
+    std::vector<int> forbidden;
+    std::vector<int> degrees;
+    std::vector<int> counts;
+    VertexBuckets buckets;
+    std::vector<unsigned long long> seenBits;
+    std::unordered_set<unsigned long long> seenColors;
+    int colorCount = 0;
+
+    static constexpr long long maxSeenBits = 1LL << 30;
+
+    template <typename TKey>
+    int ChooseColor(const CsrGraph<TKey>& graph, int vertex)
+    {
+        // forbidden[c] == vertex means color c is taken by a neighbor of vertex
+        for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+        {
+            int neighborColor = colors[graph.GetNeighbor(p)];
+
+            if (neighborColor != -1)
+                forbidden[neighborColor] = vertex;
+        }
+
+        int color = 0;
+
+        while (forbidden[color] == vertex)
+            color++;
+
+        colors[vertex] = color;
+        colorCount = std::max(colorCount, color + 1);
+
+        return color;
+    }
+
+    template <typename TKey>
+    void OrderByDegree(const CsrGraph<TKey>& graph, int maxDegree)
+    {
+        int count = graph.GetVertexCount();
+        std::vector<int>& start = counts;
+        start.assign(maxDegree + 2, 0);
+
+        for (int v = 0; v < count; v++)
+            start[maxDegree - graph.GetDegree(v) + 1]++;
+
+        for (int d = 0; d <= maxDegree; d++)
+            start[d + 1] += start[d];
+
+        for (int v = 0; v < count; v++)
+            order[start[maxDegree - graph.GetDegree(v)]++] = v;
+    }
+
+    template <typename TKey>
+    void OrderSmallestLast(const CsrGraph<TKey>& graph, int maxDegree)
+    {
+        int count = graph.GetVertexCount();
+        degrees.resize(count);
+        buckets.Reset(count, maxDegree + 1);
+
+        for (int v = count - 1; v >= 0; v--)
+        {
+            degrees[v] = graph.GetDegree(v);
+            buckets.Insert(v, degrees[v]);
+        }
+
+        int smallest = 0;
+
+        for (int position = count - 1; position >= 0; position--)
+        {
+            while (buckets.GetFirst(smallest) == -1)
+                smallest++;
+
+            int vertex = buckets.GetFirst(smallest);
+            buckets.Remove(vertex);
+            order[position] = vertex;
+
+            for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+            {
+                int neighbor = graph.GetNeighbor(p);
+
+                if (buckets.GetBucket(neighbor) != -1)
+                {
+                    buckets.Move(neighbor, --degrees[neighbor]);
+                    smallest = std::min(smallest, degrees[neighbor]);
+                }
+            }
+        }
+    }
+
+    template <typename TKey>
+    void ColorDsatur(const CsrGraph<TKey>& graph, int maxDegree)
+    {
+        int count = graph.GetVertexCount();
+        degrees.assign(count, 0);          // saturation: distinct colors among the neighbors
+        buckets.Reset(count, maxDegree + 1);
+        seenColors.clear();
+
+        // (vertex, color) pairs already counted: a bit matrix when V x (maxDegree + 1) bits fit, a hash set otherwise
+        long long wordsPerVertex = (maxDegree + 64) / 64;
+        bool useBits = wordsPerVertex * 64 * count <= maxSeenBits;
+
+        if (useBits)
+            seenBits.assign(wordsPerVertex * count, 0);
+
+        // within a bucket the last inserted vertex comes first, so ties go to the vertex of higher degree
+        OrderByDegree(graph, maxDegree);
+
+        for (int i = count - 1; i >= 0; i--)
+            buckets.Insert(order[i], 0);
+
+        int highest = 0;
+
+        for (int step = 0; step < count; step++)
+        {
+            while (buckets.GetFirst(highest) == -1)
+                highest--;
+
+            int vertex = buckets.GetFirst(highest);
+            buckets.Remove(vertex);
+            int color = ChooseColor(graph, vertex);
+
+            for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+            {
+                int neighbor = graph.GetNeighbor(p);
+
+                if (buckets.GetBucket(neighbor) == -1)
+                    continue;
+
+                if (useBits)
+                {
+                    unsigned long long& word = seenBits[neighbor * wordsPerVertex + color / 64];
+                    unsigned long long bit = 1ULL << (color % 64);
+
+                    if (word & bit)
+                        continue;
+
+                    word |= bit;
+                }
+                else if (!seenColors.insert(((unsigned long long)neighbor << 32) | (unsigned)color).second)
+                {
+                    continue;
+                }
+
+                buckets.Move(neighbor, ++degrees[neighbor]);
+                highest = std::max(highest, degrees[neighbor]);
+            }
+        }
+    }
+
+public:
+
+    template <typename TKey>
+    const std::vector<int>& Run(const CsrGraph<TKey>& graph, ColoringOrder coloringOrder = ColoringOrder::Natural)
+    {
+        int count = graph.GetVertexCount();
+        int maxDegree = 0;
+
+        for (int v = 0; v < count; v++)
+            maxDegree = std::max(maxDegree, graph.GetDegree(v));
+
+        colors.assign(count, -1);
+        order.resize(count);
+        forbidden.assign(maxDegree + 2, -1);
+        colorCount = 0;
+
+        if (coloringOrder == ColoringOrder::Dsatur)
+        {
+            ColorDsatur(graph, maxDegree);
+
+            return colors;
+        }
+
+        if (coloringOrder == ColoringOrder::LargestFirst)
+            OrderByDegree(graph, maxDegree);
+        else if (coloringOrder == ColoringOrder::SmallestLast)
+            OrderSmallestLast(graph, maxDegree);
+        else
+            for (int v = 0; v < count; v++)
+                order[v] = v;
+
+        for (int vertex : order)
+            ChooseColor(graph, vertex);
+
+        return colors;
+    }
+
+    const std::vector<int>& GetColors() const
+    {
+        return colors;
+    }
+
+    int GetColorCount() const
+    {
+        return colorCount;
+    }
+};
+
+
+enum class ParallelColoringMode {
+    JonesPlassmann,     // deterministic for a given seed, whatever the thread count
+    Speculative         // reproducible only with one thread
+};
+
+// Parallel greedy coloring.
+//   JonesPlassmann  every vertex gets a random priority from the seed; a vertex is colored in the round after all
+//                   its higher-priority neighbors, so each round colors an independent set and never conflicts.
+//                   Rounds = longest decreasing-priority path.
+//   Speculative     Gebremedhin-Manne: all pending vertices are colored at once from whatever their neighbors show,
+//                   then every conflicting edge sends its higher-id endpoint back to the pending list.
+// Both pick the smallest color not used by a neighbor, through a per-thread stamp array.
+class ParallelColoringEngine {
+private:
+
+    ThreadPool pool;
+    std::vector<int> colors;
+    std::vector<unsigned> priorities;
+    std::vector<int> waiting;               // higher-priority neighbors not colored yet
+    std::vector<int> frontier;
+    std::vector<std::vector<int>> threadFrontiers;
+    std::vector<std::vector<int>> forbidden;
+    int roundCount = 0;
+    long long conflictCount = 0;
+    int colorCount = 0;
+
+    static unsigned MixPriority(unsigned long long seed, int vertex)
+    {
+        // splitmix64 finalizer
+        unsigned long long value = seed + 0x9e3779b97f4a7c15ULL * (unsigned long long)(vertex + 1);
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+
+        return (unsigned)(value ^ (value >> 31));
+    }
+
+    bool HasPriority(int vertex, int other) const
+    {
+        return priorities[vertex] > priorities[other] || (priorities[vertex] == priorities[other] && vertex < other);
+    }
+
+    static int LoadColor(int& color)
+    {
+        return std::atomic_ref<int>(color).load(std::memory_order_relaxed);
+    }
+
+    template <typename TKey>
+    int ChooseColor(const CsrGraph<TKey>& graph, int thread, int vertex)
+    {
+        std::vector<int>& stamps = forbidden[thread];
+
+        for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+        {
+            int neighbor = graph.GetNeighbor(p);
+            int neighborColor = neighbor == vertex ? -1 : LoadColor(colors[neighbor]);
+
+            if (neighborColor != -1)
+                stamps[neighborColor] = vertex;
+        }
+
+        int color = 0;
+
+        while (stamps[color] == vertex)
+            color++;
+
+        return color;
+    }
+
+    // Moves the per-thread lists into frontier.
+    void GatherFrontier()
+    {
+        frontier.clear();
+
+        for (auto& list : threadFrontiers)
+        {
+            frontier.insert(frontier.end(), list.begin(), list.end());
+            list.clear();
+        }
+    }
+
+    template <typename TKey>
+    void RunJonesPlassmann(const CsrGraph<TKey>& graph, unsigned long long seed)
+    {
+        int count = graph.GetVertexCount();
+        priorities.resize(count);
+        waiting.assign(count, 0);
+
+        pool.ParallelFor(count, 4096, [&](int thread, int begin, int end) {
+            for (int v = begin; v < end; v++)
+                priorities[v] = MixPriority(seed, v);
+        });
+
+        pool.ParallelFor(count, 4096, [&](int thread, int begin, int end) {
+            for (int v = begin; v < end; v++)
+            {
+                for (int p = graph.NeighborsBegin(v); p < graph.NeighborsEnd(v); p++)
+                    if (graph.GetNeighbor(p) != v && HasPriority(graph.GetNeighbor(p), v))
+                        waiting[v]++;
+
+                if (waiting[v] == 0)
+                    threadFrontiers[thread].push_back(v);
+            }
+        });
+
+        GatherFrontier();
+
+        while (!frontier.empty())
+        {
+            roundCount++;
+
+            pool.ParallelFor((int)frontier.size(), 256, [&](int thread, int begin, int end) {
+                for (int i = begin; i < end; i++)
+                {
+                    int vertex = frontier[i];
+                    std::atomic_ref<int>(colors[vertex]).store(ChooseColor(graph, thread, vertex), std::memory_order_relaxed);
+
+                    for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+                    {
+                        int neighbor = graph.GetNeighbor(p);
+
+                        if (neighbor == vertex || !HasPriority(vertex, neighbor))
+                            continue;
+
+                        if (std::atomic_ref<int>(waiting[neighbor]).fetch_sub(1, std::memory_order_acq_rel) == 1)
+                            threadFrontiers[thread].push_back(neighbor);
+                    }
+                }
+            });
+
+            GatherFrontier();
+        }
+    }
+
+    template <typename TKey>
+    void RunSpeculative(const CsrGraph<TKey>& graph)
+    {
+        int count = graph.GetVertexCount();
+        frontier.resize(count);
+
+        for (int v = 0; v < count; v++)
+            frontier[v] = v;
+
+        while (!frontier.empty())
+        {
+            roundCount++;
+
+            pool.ParallelFor((int)frontier.size(), 256, [&](int thread, int begin, int end) {
+                for (int i = begin; i < end; i++)
+                    std::atomic_ref<int>(colors[frontier[i]]).store(ChooseColor(graph, thread, frontier[i]), std::memory_order_relaxed);
+            });
+
+            // only vertices colored in the same round can clash; the one with the higher id goes again
+            pool.ParallelFor((int)frontier.size(), 256, [&](int thread, int begin, int end) {
+                for (int i = begin; i < end; i++)
+                {
+                    int vertex = frontier[i];
+
+                    for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+                    {
+                        int neighbor = graph.GetNeighbor(p);
+
+                        if (neighbor < vertex && colors[neighbor] == colors[vertex])
+                        {
+                            threadFrontiers[thread].push_back(vertex);
+                            break;
+                        }
+                    }
+                }
+            });
+
+            GatherFrontier();
+            std::sort(frontier.begin(), frontier.end());
+            conflictCount += (long long)frontier.size();
+
+            // a recolored vertex must not read the stale color of another pending one
+            for (int vertex : frontier)
+                colors[vertex] = -1;
+        }
+    }
+
+public:
+
+    explicit ParallelColoringEngine(int threadCount = 0)
+            : pool(threadCount), threadFrontiers(pool.GetThreadCount()), forbidden(pool.GetThreadCount()) {}
+
+    template <typename TKey>
+    const std::vector<int>& Run(const CsrGraph<TKey>& graph, ParallelColoringMode mode = ParallelColoringMode::JonesPlassmann,
+                                unsigned long long seed = 1)
+    {
+        int count = graph.GetVertexCount();
+        int maxDegree = 0;
+
+        for (int v = 0; v < count; v++)
+            maxDegree = std::max(maxDegree, graph.GetDegree(v));
+
+        colors.assign(count, -1);
+
+        for (auto& stamps : forbidden)
+            stamps.assign(maxDegree + 2, -1);
+
+        roundCount = 0;
+        conflictCount = 0;
+
+        if (mode == ParallelColoringMode::Speculative)
+            RunSpeculative(graph);
+        else
+            RunJonesPlassmann(graph, seed);
+
+        colorCount = colors.empty() ? 0 : *std::max_element(colors.begin(), colors.end()) + 1;
+
+        return colors;
+    }
+
+    const std::vector<int>& GetColors() const
+    {
+        return colors;
+    }
+
+    int GetColorCount() const
+    {
+        return colorCount;
+    }
+
+    int GetRoundCount() const
+    {
+        return roundCount;
+    }
+
+    // Vertices sent back for recoloring, summed over the rounds; always 0 for Jones-Plassmann.
+    long long GetConflictCount() const
+    {
+        return conflictCount;
+    }
+
+    int GetThreadCount() const
+    {
+        return pool.GetThreadCount();
+    }
+};
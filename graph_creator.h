@@ -1,7 +1,7 @@
-#pragma once
-
-#include "undirected_graph.h"
-
-
-
+#pragma once
+
+#include "undirected_graph.h"
+
+
+
 UndirectedGraph<int> GenerateGraph(int vertexCount, int edgeCount, int minWeight, int maxWeight);
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+
+
+// Receives UndirectedGraph mutations after they have been applied.
+// RemoveVertex reports every incident edge through OnEdgeRemoved before OnVertexRemoved.
+// Observers must not subscribe or unsubscribe from inside a notification.
+template <typename TKey>
+class IGraphObserver {
+
+public:
+
+    virtual ~IGraphObserver() = default;
+
+    virtual void OnVertexAdded(const TKey& vertex) {}
+    virtual void OnVertexRemoved(const TKey& vertex) {}
+    virtual void OnEdgeAdded(const TKey& vertex1, const TKey& vertex2, int weight) {}
+    virtual void OnEdgeRemoved(const TKey& vertex1, const TKey& vertex2, int weight) {}
+
+    // Another graph was assigned to the watched one; everything may have changed.
+    virtual void OnGraphReplaced() {}
+};
+
+
+// Subscriptions belong to one graph object: copies and moves of a graph start without observers,
+// and assigning a graph keeps the observers of the target and tells them about it. The list has to be the
+// last member of the graph so that the rest of it is already assigned at that point.
+template <typename TKey>
+class GraphObserverList {
+private:
+
+    std::vector<IGraphObserver<TKey>*> observers;
+
+public:
+
+    GraphObserverList() = default;
+    GraphObserverList(const GraphObserverList&) {}
+
+    GraphObserverList& operator=(const GraphObserverList&)
+    {
+        Notify([](IGraphObserver<TKey>* observer) { observer->OnGraphReplaced(); });
+
+        return *this;
+    }
+
+    void Subscribe(IGraphObserver<TKey>* observer)
+    {
+        if (std::find(observers.begin(), observers.end(), observer) == observers.end())
+            observers.push_back(observer);
+    }
+
+    void Unsubscribe(IGraphObserver<TKey>* observer)
+    {
+        observers.erase(std::remove(observers.begin(), observers.end(), observer), observers.end());
+    }
+
+    template <typename TFunction>
+    void Notify(TFunction function) const
+    {
+        for (IGraphObserver<TKey>* observer : observers)
+            function(observer);
+    }
+};
@@ -1,235 +1,364 @@
-#pragma once
-
-#include <optional>
-
-#include "idictionary.h"
-#include "unique_pointer.h"
-#include "dynamic_array.h"
-#include "array_sequence.h"
-
-
-
-template <typename TKey, typename TValue>
-class HashNode
-{
-public:
-    TKey key;
-    TValue value;
-
-    HashNode(TKey key, TValue value) : key(key), value(value) {}
-};
-
-template <typename TKey, typename TValue, typename Hash = std::hash<TKey>>
-class HashTable : public IDictionary<TKey, TValue>
-{
-private:
-
-    ArraySequence<UniquePointer<HashNode<TKey, TValue>>> array;
-    int capacity;
-    int size;
-    Hash hashFunction;
-
-    void Resize(int newCapacity)
-    {
-        int oldCapacity = capacity;
-        capacity = newCapacity;
-        ArraySequence<UniquePointer<HashNode<TKey, TValue>>> newArray(capacity);
-
-        for (int i = 0; i < oldCapacity; i++)
-        {
-            if (array[i].Get())
-            {
-                int hashIndex = HashCode(array[i].Get()->key);
-
-                while (newArray[hashIndex].Get())
-                    hashIndex = (hashIndex + 1) % capacity;
-
-                newArray[hashIndex] = std::move(array[i]);
-            }
-        }
-
-        array = std::move(newArray);
-    }
-
-public:
-
-    HashTable(int capacity = 20)
-    {
-        int thisCapacity;
-
-        if (capacity <= 0)
-        {
-            thisCapacity = 20;
-        }
-        else
-        {
-            thisCapacity = capacity;
-        }
-
-        this->capacity = thisCapacity;
-        size = 0;
-        array = ArraySequence<UniquePointer<HashNode<TKey, TValue>>>(thisCapacity);
-    }
-
-    HashTable(HashTable&& other) noexcept
-            : array(std::move(other.array)),
-              capacity(other.capacity),
-              size(other.size),
-              hashFunction(std::move(other.hashFunction))
-    {
-        other.capacity = 0;
-        other.size = 0;
-    }
-
-    HashTable& operator=(const HashTable& other)
-    {
-        if (this != &other)
-        {
-            array = std::move(other.array);
-            capacity = other.capacity;
-            size = other.size;
-            hashFunction = std::move(other.hashFunction);
-        }
-
-        return *this;
-    }
-
-    HashTable& operator=(HashTable&& other) noexcept
-    {
-        if (this != &other)
-        {
-            array = std::move(other.array);
-            capacity = other.capacity;
-            size = other.size;
-            hashFunction = std::move(other.hashFunction);
-        }
-
-        return *this;
-    }
-
-    ~HashTable() = default;
-
-    int HashCode(const TKey& key) const
-    {
-        return hashFunction(key) % capacity;
-    }
-
-    void Add(const TKey& key, const TValue& value) override
-    {
-        if (size >= capacity * 0.7)
-            Resize(capacity * 2);
-
-        int hashIndex = HashCode(key);
-
-        while (array[hashIndex].Get())
-        {
-            if (array[hashIndex].Get()->key == key)
-            {
-                array[hashIndex].Get()->value = value;
-                return;
-            }
-            else
-            {
-                hashIndex = (hashIndex + 1) % capacity;
-            }
-        }
-
-        array[hashIndex] = UniquePointer<HashNode<TKey, TValue>>(new HashNode<TKey, TValue>(key, value));
-        size++;
-    }
-
-    void Remove(const TKey& key) override
-    {
-        int hashIndex = HashCode(key);
-
-        while (array[hashIndex].Get())
-        {
-            if (array[hashIndex].Get()->key == key)
-            {
-                array[hashIndex].Reset();
-                size--;
-
-                int nextIndex = (hashIndex + 1) % capacity;
-                while (array[nextIndex].Get())
-                {
-                    auto node = std::move(array[nextIndex]);
-                    array[nextIndex].Reset();
-                    size--;
-                    int newIndex = HashCode(node->key);
-
-                    while (array[newIndex].Get())
-                        newIndex = (newIndex + 1) % capacity;
-
-                    array[newIndex] = std::move(node);
-                    size++;
-                    nextIndex = (nextIndex + 1) % capacity;
-                }
-
-                if (size <= capacity / 4 && capacity > 20)
-                    Resize(std::max(20, capacity / 2));
-
-                return;
-            }
-
-            hashIndex = (hashIndex + 1) % capacity;
-        }
-    }
-
-
-    std::optional<TValue> GetValue(const TKey& key) const override
-    {
-        int hashIndex = HashCode(key);
-
-        while (array[hashIndex].Get())
-        {
-            if (array[hashIndex].Get()->key == key)
-            {
-                return array[hashIndex].Get()->value;
-            }
-
-            hashIndex = (hashIndex + 1) % capacity;
-        }
-
-        return std::nullopt;
-    }
-
-    bool ContainsKey(const TKey& key) const override
-    {
-        return GetValue(key).has_value();
-    }
-
-    int GetCount() const override
-    {
-        return size;
-    }
-
-    int GetCapacity() const override
-    {
-        return capacity;
-    }
-
-    bool IsEmpty() const
-    {
-        return size == 0;
-    }
-
-    bool ConstainsIndex(const int index) const
-    {
-        if (index < 0 || index > capacity)
-        {
-            return false;
-        }
-
-        return array[index].Get() != nullptr;
-    }
-
-    TKey& GetKeyByIndex(const int index) const
-    {
-        return array[index].Get()->key;
-    }
-
-    TValue& GetValueByIndex(const int index) const
-    {
-        return array[index].Get()->value;
-    }
-};
+#pragma once
+
+#include <optional>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include "idictionary.h"
+#include "unique_pointer.h"
+#include "dynamic_array.h"
+#include "array_sequence.h"
+
+
+
+template <typename TKey, typename TValue>
+class HashNode
+{
+public:
+    TKey key;
+    TValue value;
+    int distance = 0;   // slots between the home slot of the key and the slot the node sits in
+
+    HashNode(TKey key, TValue value) : key(key), value(value) {}
+
+    // Builds the value in place from args.
+    template <typename... TArgs>
+    HashNode(const TKey& key, std::in_place_t, TArgs&&... args) : key(key), value(std::forward<TArgs>(args)...) {}
+};
+
+// Probe lengths over all entries; histogram[d] counts entries that sit d slots past their home slot, so a
+// lookup for them inspects d + 1 slots.
+struct ProbeStatistics {
+    int maxLength = 0;
+    double averageLength = 0;
+    std::vector<int> histogram;
+};
+
+// Linear probing with Robin Hood placement: an insert takes over the slot of any entry that is closer to its
+// home than the insert is to its own, so probe lengths stay short and even, and a lookup can stop as soon as
+// it meets such an entry. Remove shifts the rest of the cluster one slot back (no tombstones, no rehashing).
+// The table doubles above 70% load and halves below 1/8, so that after either resize there is a wide margin
+// before the next one and alternating inserts and removes cannot make it thrash.
+template <typename TKey, typename TValue, typename Hash = std::hash<TKey>>
+class HashTable : public IDictionary<TKey, TValue>
+{
+private:
+
+    static constexpr int minCapacity = 20;
+    static constexpr double maxLoadFactor = 0.7;
+    static constexpr int shrinkDivisor = 8;
+
+    ArraySequence<UniquePointer<HashNode<TKey, TValue>>> array;
+    int capacity;
+    int size;
+    int resizeCount = 0;
+    Hash hashFunction;
+
+    int Next(int index) const
+    {
+        return index + 1 == capacity ? 0 : index + 1;
+    }
+
+    // Robin Hood insertion of a node whose key is not in the table yet.
+    void Place(UniquePointer<HashNode<TKey, TValue>> node)
+    {
+        int hashIndex = HashCode(node->key);
+        node->distance = 0;
+
+        while (array[hashIndex].Get())
+        {
+            if (array[hashIndex]->distance < node->distance)
+                std::swap(array[hashIndex], node);
+
+            hashIndex = Next(hashIndex);
+            node->distance++;
+        }
+
+        array[hashIndex] = std::move(node);
+    }
+
+    // TLookup is TKey, or anything the hash accepts when it is transparent (see StringHash).
+    template <typename TLookup>
+    int FindIndex(const TLookup& key) const
+    {
+        if (capacity == 0)
+            return -1;
+
+        int hashIndex = hashFunction(key) % capacity;
+
+        for (int distance = 0; array[hashIndex].Get() && array[hashIndex]->distance >= distance; distance++)
+        {
+            if (array[hashIndex]->key == key)
+                return hashIndex;
+
+            hashIndex = Next(hashIndex);
+        }
+
+        return -1;
+    }
+
+    void GrowForInsert()
+    {
+        if (capacity == 0)
+            Resize(minCapacity);
+        else if (size + 1 > capacity * maxLoadFactor)
+            Resize(capacity * 2);
+    }
+
+    void Resize(int newCapacity)
+    {
+        int oldCapacity = capacity;
+        ArraySequence<UniquePointer<HashNode<TKey, TValue>>> oldArray = std::move(array);
+
+        capacity = newCapacity;
+        array = ArraySequence<UniquePointer<HashNode<TKey, TValue>>>(capacity);
+
+        for (int i = 0; i < oldCapacity; i++)
+            if (oldArray[i].Get())
+                Place(std::move(oldArray[i]));
+
+        resizeCount++;
+    }
+
+public:
+
+    HashTable(int capacity = 20)
+    {
+        int thisCapacity;
+
+        if (capacity <= 0)
+        {
+            thisCapacity = 20;
+        }
+        else
+        {
+            thisCapacity = capacity;
+        }
+
+        this->capacity = thisCapacity;
+        size = 0;
+        array = ArraySequence<UniquePointer<HashNode<TKey, TValue>>>(thisCapacity);
+    }
+
+    HashTable(HashTable&& other) noexcept
+            : array(std::move(other.array)),
+              capacity(other.capacity),
+              size(other.size),
+              resizeCount(other.resizeCount),
+              hashFunction(std::move(other.hashFunction))
+    {
+        other.capacity = 0;
+        other.size = 0;
+    }
+
+    HashTable& operator=(const HashTable& other)
+    {
+        if (this != &other)
+        {
+            array = std::move(other.array);
+            capacity = other.capacity;
+            size = other.size;
+            resizeCount = other.resizeCount;
+            hashFunction = std::move(other.hashFunction);
+        }
+
+        return *this;
+    }
+
+    HashTable& operator=(HashTable&& other) noexcept
+    {
+        if (this != &other)
+        {
+            array = std::move(other.array);
+            capacity = other.capacity;
+            size = other.size;
+            resizeCount = other.resizeCount;
+            hashFunction = std::move(other.hashFunction);
+        }
+
+        return *this;
+    }
+
+    ~HashTable() = default;
+
+    int HashCode(const TKey& key) const
+    {
+        return hashFunction(key) % capacity;
+    }
+
+    void Add(const TKey& key, const TValue& value) override
+    {
+        auto [stored, inserted] = TryEmplace(key, value);
+
+        if (!inserted)
+            *stored = value;
+    }
+
+    // Inserts a value built from args unless the key is present; nothing is built then. Returns the stored
+    // value and whether it was inserted. Nodes never move, so the pointer stays valid until the key is removed.
+    template <typename... TArgs>
+    std::pair<TValue*, bool> TryEmplace(const TKey& key, TArgs&&... args)
+    {
+        int index = FindIndex(key);
+
+        if (index != -1)
+            return {&array[index]->value, false};
+
+        GrowForInsert();
+
+        HashNode<TKey, TValue>* node = new HashNode<TKey, TValue>(key, std::in_place, std::forward<TArgs>(args)...);
+        Place(UniquePointer<HashNode<TKey, TValue>>(node));
+        size++;
+
+        return {&node->value, true};
+    }
+
+    TValue& GetOrInsert(const TKey& key, const TValue& value = TValue()) override
+    {
+        return *TryEmplace(key, value).first;
+    }
+
+    TValue* Find(const TKey& key) override
+    {
+        int index = FindIndex(key);
+
+        return index == -1 ? nullptr : &array[index]->value;
+    }
+
+    const TValue* Find(const TKey& key) const override
+    {
+        int index = FindIndex(key);
+
+        return index == -1 ? nullptr : &array[index]->value;
+    }
+
+    // Heterogeneous lookup, e.g. std::string_view in a HashTable<std::string, TValue, StringHash>.
+    template <typename TLookup> requires requires { typename Hash::is_transparent; }
+    TValue* Find(const TLookup& key)
+    {
+        int index = FindIndex(key);
+
+        return index == -1 ? nullptr : &array[index]->value;
+    }
+
+    template <typename TLookup> requires requires { typename Hash::is_transparent; }
+    const TValue* Find(const TLookup& key) const
+    {
+        int index = FindIndex(key);
+
+        return index == -1 ? nullptr : &array[index]->value;
+    }
+
+    template <typename TLookup> requires requires { typename Hash::is_transparent; }
+    bool ContainsKey(const TLookup& key) const
+    {
+        return FindIndex(key) != -1;
+    }
+
+    bool Remove(const TKey& key) override
+    {
+        int hashIndex = FindIndex(key);
+
+        if (hashIndex == -1)
+            return false;
+
+        array[hashIndex].Reset();
+        size--;
+
+        // backward shift: every following entry that is not in its home slot moves one slot closer to it
+        for (int nextIndex = Next(hashIndex); array[nextIndex].Get() && array[nextIndex]->distance > 0; nextIndex = Next(nextIndex))
+        {
+            array[hashIndex] = std::move(array[nextIndex]);
+            array[hashIndex]->distance--;
+            hashIndex = nextIndex;
+        }
+
+        if (size < capacity / shrinkDivisor && capacity > minCapacity)
+            Resize(std::max(minCapacity, capacity / 2));
+
+        return true;
+    }
+
+    std::optional<TValue> GetValue(const TKey& key) const override
+    {
+        int index = FindIndex(key);
+
+        if (index == -1)
+            return std::nullopt;
+
+        return array[index]->value;
+    }
+
+    bool ContainsKey(const TKey& key) const override
+    {
+        return FindIndex(key) != -1;
+    }
+
+    int GetCount() const override
+    {
+        return size;
+    }
+
+    int GetCapacity() const override
+    {
+        return capacity;
+    }
+
+    bool IsEmpty() const
+    {
+        return size == 0;
+    }
+
+    // Grows and shrinks so far.
+    int GetResizeCount() const
+    {
+        return resizeCount;
+    }
+
+    ProbeStatistics GetProbeStatistics() const
+    {
+        ProbeStatistics statistics;
+        long long total = 0;
+
+        for (int i = 0; i < capacity; i++)
+        {
+            if (!array[i].Get())
+                continue;
+
+            int distance = array[i]->distance;
+
+            if (distance >= (int)statistics.histogram.size())
+                statistics.histogram.resize(distance + 1, 0);
+
+            statistics.histogram[distance]++;
+            statistics.maxLength = std::max(statistics.maxLength, distance);
+            total += distance;
+        }
+
+        statistics.averageLength = size == 0 ? 0 : (double)total / size;
+
+        return statistics;
+    }
+
+    bool ConstainsIndex(const int index) const
+    {
+        if (index < 0 || index > capacity)
+        {
+            return false;
+        }
+
+        return array[index].Get() != nullptr;
+    }
+
+    TKey& GetKeyByIndex(const int index) const
+    {
+        return array[index].Get()->key;
+    }
+
+    TValue& GetValueByIndex(const int index) const
+    {
+        return array[index].Get()->value;
+    }
+};
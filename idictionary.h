@@ -1,21 +1,46 @@
-#pragma once
-
-#include <optional>
-
-
-
-template <typename TKey, typename TValue>
-class IDictionary {
-
-public:
-
-    virtual ~IDictionary() = default;
-
-    virtual int GetCount() const = 0;
-    virtual int GetCapacity() const = 0;
-
-    virtual std::optional<TValue> GetValue(const TKey& key) const = 0;
-    virtual bool ContainsKey(const TKey& key) const = 0;
-    virtual void Add(const TKey& key, const TValue& element) = 0;
-    virtual void Remove(const TKey& key) = 0;
-};
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <functional>
+
+
+
+// Hash for std::string keys that also accepts std::string_view and string literals, so a table declared with
+// it can be probed without building a std::string. A single string_view overload takes all three; a second one
+// for std::string would make literals ambiguous.
+struct StringHash {
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view value) const
+    {
+        return std::hash<std::string_view>()(value);
+    }
+};
+
+
+template <typename TKey, typename TValue>
+class IDictionary {
+
+public:
+
+    virtual ~IDictionary() = default;
+
+    virtual int GetCount() const = 0;
+    virtual int GetCapacity() const = 0;
+
+    virtual std::optional<TValue> GetValue(const TKey& key) const = 0;
+    virtual bool ContainsKey(const TKey& key) const = 0;
+    virtual void Add(const TKey& key, const TValue& element) = 0;
+    // Returns whether the key was present.
+    virtual bool Remove(const TKey& key) = 0;
+
+    // The stored value in place, nullptr if the key is absent. The pointer stays valid until the table is
+    // next modified.
+    virtual TValue* Find(const TKey& key) = 0;
+    virtual const TValue* Find(const TKey& key) const = 0;
+
+    // The stored value, after inserting value for an absent key.
+    virtual TValue& GetOrInsert(const TKey& key, const TValue& value = TValue()) = 0;
+};
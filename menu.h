@@ -1,5 +1,5 @@
-#pragma once
-
-
-
+#pragma once
+
+
+
 void Menu();
\ No newline at end of file
@@ -0,0 +1,377 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "edge.h"
+#include "disjoint_set.h"
+#include "thread_pool.h"
+
+#include <vector>
+#include <array>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <limits>
+
+
+
+enum class MstAlgorithm {
+    Kruskal,
+    FilterKruskal,
+    Boruvka
+};
+
+// Minimum spanning forests of large graphs over dense ids.
+// The edge list is cut straight out of the CSR arrays, each edge once from its smaller dense id, and every
+// algorithm returns the same contract: (index, index, weight) edges of a minimum spanning forest, with CSR
+// vertex indices as endpoints, so any key type works and callers map back with GetVertex. Among several
+// minimum forests the algorithms may pick different ones, and all may differ from
+// FindMinimumSpanningTreeKruskal; the total weight does not. Buffers are kept between runs.
+//
+//   Kruskal        parallel LSD radix sort on the weight (only as many 8-bit passes as the weight range
+//                  needs), then one scan with a flat DisjointSet
+//   FilterKruskal  Osipov, Sanders, Singler: split around a random pivot weight, solve the light part, drop
+//                  heavy edges that already close a cycle, recurse on the rest; heavy edges are mostly never sorted
+//   Boruvka        every component picks its lightest outgoing edge in parallel, components are contracted
+//                  and edges inside them dropped, until no edge between components is left
+class MinimumSpanningTreeEngine {
+private:
+
+    struct IndexedEdge {
+        int weight;
+        int vertex1;
+        int vertex2;
+    };
+
+    static constexpr int baseCaseSize = 4096;
+    static constexpr int parallelSize = 1 << 15;
+
+    ThreadPool pool;
+    std::mt19937 random;
+    std::vector<IndexedEdge> edges;
+    std::vector<IndexedEdge> buffer;
+    std::vector<int> firstEdge;
+    std::vector<std::vector<int>> histograms;
+    std::vector<std::array<int, 3>> groupCounts;
+    DisjointSet components;
+    std::vector<int> labels;
+    std::vector<unsigned long long> lightest;
+    std::vector<WeightedEdge> forest;
+    int vertexCount = 0;
+
+    template <typename TKey>
+    void CollectEdges(const CsrGraph<TKey>& graph)
+    {
+        int count = graph.GetVertexCount();
+        firstEdge.assign(count + 1, 0);
+
+        pool.ParallelFor(count, 4096, [&](int thread, int begin, int end) {
+            for (int u = begin; u < end; u++)
+                for (int p = graph.NeighborsBegin(u); p < graph.NeighborsEnd(u); p++)
+                    if (u < graph.GetNeighbor(p))
+                        firstEdge[u + 1]++;
+        });
+
+        for (int u = 0; u < count; u++)
+            firstEdge[u + 1] += firstEdge[u];
+
+        edges.resize(firstEdge[count]);
+        buffer.resize(edges.size());
+
+        pool.ParallelFor(count, 4096, [&](int thread, int begin, int end) {
+            for (int u = begin; u < end; u++)
+            {
+                int position = firstEdge[u];
+
+                for (int p = graph.NeighborsBegin(u); p < graph.NeighborsEnd(u); p++)
+                    if (u < graph.GetNeighbor(p))
+                        edges[position++] = IndexedEdge{graph.GetWeight(p), u, graph.GetNeighbor(p)};
+            }
+        });
+    }
+
+    int GetSliceCount(int length) const
+    {
+        return length >= parallelSize ? pool.GetThreadCount() : 1;
+    }
+
+    // Runs function(slice, begin, end) over slices of [begin, end) that stay in order.
+    template <typename TFunction>
+    void ForEachSlice(int begin, int end, int slices, TFunction function)
+    {
+        auto run = [&](int slice) {
+            long long length = end - begin;
+            function(slice, begin + (int)(length * slice / slices), begin + (int)(length * (slice + 1) / slices));
+        };
+
+        if (slices == 1)
+            run(0);
+        else
+            pool.Run(run);
+    }
+
+    // Stable in-place split of edges[begin, end) into the groups 0, 1, 2 given by group(edge); edges of
+    // group 3 are dropped. Returns the size of every kept group.
+    template <typename TGroup>
+    std::array<int, 3> Split(int begin, int end, TGroup group)
+    {
+        int slices = GetSliceCount(end - begin);
+        groupCounts.assign(slices, std::array<int, 3>{0, 0, 0});
+
+        ForEachSlice(begin, end, slices, [&](int slice, int sliceBegin, int sliceEnd) {
+            for (int i = sliceBegin; i < sliceEnd; i++)
+            {
+                int target = group(edges[i]);
+
+                if (target < 3)
+                    groupCounts[slice][target]++;
+            }
+        });
+
+        std::array<int, 3> sizes{0, 0, 0};
+        int offset = begin;
+
+        for (int target = 0; target < 3; target++)
+        {
+            for (int slice = 0; slice < slices; slice++)
+            {
+                int amount = groupCounts[slice][target];
+                groupCounts[slice][target] = offset;
+                offset += amount;
+                sizes[target] += amount;
+            }
+        }
+
+        ForEachSlice(begin, end, slices, [&](int slice, int sliceBegin, int sliceEnd) {
+            std::array<int, 3>& position = groupCounts[slice];
+
+            for (int i = sliceBegin; i < sliceEnd; i++)
+            {
+                int target = group(edges[i]);
+
+                if (target < 3)
+                    buffer[position[target]++] = edges[i];
+            }
+        });
+
+        ForEachSlice(begin, offset, GetSliceCount(offset - begin), [&](int slice, int sliceBegin, int sliceEnd) {
+            std::copy(buffer.begin() + sliceBegin, buffer.begin() + sliceEnd, edges.begin() + sliceBegin);
+        });
+
+        return sizes;
+    }
+
+    // Stable sort of all edges by weight. Every thread owns one contiguous slice: it counts the digits of its
+    // slice, and after a prefix sum over (digit, thread) scatters the slice in order.
+    void RadixSortByWeight()
+    {
+        int count = (int)edges.size();
+
+        if (count < 2)
+            return;
+
+        auto byWeight = [](const IndexedEdge& a, const IndexedEdge& b) { return a.weight < b.weight; };
+        int minWeight = std::min_element(edges.begin(), edges.end(), byWeight)->weight;
+        int maxWeight = std::max_element(edges.begin(), edges.end(), byWeight)->weight;
+        unsigned range = (unsigned)maxWeight - (unsigned)minWeight;
+
+        int threads = pool.GetThreadCount();
+        histograms.assign(threads, std::vector<int>(256));
+
+        for (int shift = 0; shift < 32 && (range >> shift) != 0; shift += 8)
+        {
+            auto digit = [&](const IndexedEdge& edge) {
+                return (int)((((unsigned)edge.weight - (unsigned)minWeight) >> shift) & 255);
+            };
+
+            ForEachSlice(0, count, threads, [&](int thread, int begin, int end) {
+                std::vector<int>& histogram = histograms[thread];
+                std::fill(histogram.begin(), histogram.end(), 0);
+
+                for (int i = begin; i < end; i++)
+                    histogram[digit(edges[i])]++;
+            });
+
+            int offset = 0;
+
+            for (int d = 0; d < 256; d++)
+            {
+                for (int thread = 0; thread < threads; thread++)
+                {
+                    int amount = histograms[thread][d];
+                    histograms[thread][d] = offset;
+                    offset += amount;
+                }
+            }
+
+            ForEachSlice(0, count, threads, [&](int thread, int begin, int end) {
+                std::vector<int>& position = histograms[thread];
+
+                for (int i = begin; i < end; i++)
+                    buffer[position[digit(edges[i])]++] = edges[i];
+            });
+
+            edges.swap(buffer);
+        }
+    }
+
+    // Adds edges[begin, end) in their current order; stops once the forest is a spanning tree.
+    void Scan(int begin, int end)
+    {
+        for (int i = begin; i < end && (int)forest.size() < vertexCount - 1; i++)
+            if (components.Union(edges[i].vertex1, edges[i].vertex2))
+                forest.push_back(WeightedEdge(edges[i].vertex1, edges[i].vertex2, edges[i].weight));
+    }
+
+    void RunKruskal()
+    {
+        RadixSortByWeight();
+        Scan(0, (int)edges.size());
+    }
+
+    void FilterKruskal(int begin, int end)
+    {
+        if (begin >= end || (int)forest.size() == vertexCount - 1)
+            return;
+
+        if (end - begin <= baseCaseSize)
+        {
+            std::sort(edges.begin() + begin, edges.begin() + end, [](const IndexedEdge& a, const IndexedEdge& b) {
+                return a.weight < b.weight;
+            });
+
+            Scan(begin, end);
+
+            return;
+        }
+
+        std::uniform_int_distribution<int> positionDis(begin, end - 1);
+        std::array<int, 3> samples{edges[positionDis(random)].weight, edges[positionDis(random)].weight,
+                                   edges[positionDis(random)].weight};
+        std::sort(samples.begin(), samples.end());
+        int pivot = samples[1];
+
+        std::array<int, 3> sizes = Split(begin, end, [pivot](const IndexedEdge& edge) {
+            return edge.weight < pivot ? 0 : edge.weight == pivot ? 1 : 2;
+        });
+
+        int lightEnd = begin + sizes[0];
+        int equalEnd = lightEnd + sizes[1];
+
+        FilterKruskal(begin, lightEnd);
+        Scan(lightEnd, equalEnd);
+
+        if ((int)forest.size() == vertexCount - 1)
+            return;
+
+        // No unions happen while filtering, so FindRoot may run on many threads at once.
+        std::array<int, 3> kept = Split(equalEnd, end, [this](const IndexedEdge& edge) {
+            return components.FindRoot(edge.vertex1) == components.FindRoot(edge.vertex2) ? 3 : 0;
+        });
+
+        FilterKruskal(equalEnd, equalEnd + kept[0]);
+    }
+
+    static bool LowerKey(unsigned long long& target, unsigned long long candidate)
+    {
+        std::atomic_ref<unsigned long long> key(target);
+        unsigned long long current = key.load(std::memory_order_relaxed);
+
+        while (candidate < current)
+            if (key.compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+                return true;
+
+        return false;
+    }
+
+    void RunBoruvka()
+    {
+        const unsigned long long none = std::numeric_limits<unsigned long long>::max();
+        int edgeCount = (int)edges.size();
+
+        labels.resize(vertexCount);
+        lightest.assign(vertexCount, none);
+
+        for (int v = 0; v < vertexCount; v++)
+            labels[v] = v;
+
+        int minWeight = 0;
+
+        for (const IndexedEdge& edge : edges)
+            minWeight = std::min(minWeight, edge.weight);
+
+        while (edgeCount > 0)
+        {
+            // (weight, position) packed into one key, so every component sees the same strict order of
+            // edges and the picked edges can never close a cycle.
+            pool.ParallelFor(edgeCount, 4096, [&](int thread, int begin, int end) {
+                for (int i = begin; i < end; i++)
+                {
+                    unsigned long long key = ((unsigned long long)((unsigned)edges[i].weight - (unsigned)minWeight) << 32) | (unsigned)i;
+                    LowerKey(lightest[labels[edges[i].vertex1]], key);
+                    LowerKey(lightest[labels[edges[i].vertex2]], key);
+                }
+            });
+
+            for (int v = 0; v < vertexCount; v++)
+            {
+                if (labels[v] != v || lightest[v] == none)
+                    continue;
+
+                const IndexedEdge& edge = edges[(int)(lightest[v] & 0xffffffffULL)];
+                lightest[v] = none;
+
+                if (components.Union(edge.vertex1, edge.vertex2))
+                    forest.push_back(WeightedEdge(edge.vertex1, edge.vertex2, edge.weight));
+            }
+
+            pool.ParallelFor(vertexCount, 4096, [&](int thread, int begin, int end) {
+                for (int v = begin; v < end; v++)
+                    labels[v] = components.FindRoot(v);
+            });
+
+            edgeCount = Split(0, edgeCount, [this](const IndexedEdge& edge) {
+                return labels[edge.vertex1] == labels[edge.vertex2] ? 3 : 0;
+            })[0];
+        }
+    }
+
+public:
+
+    explicit MinimumSpanningTreeEngine(int threadCount = 0) : pool(threadCount), random(20240601) {}
+
+    // Minimum spanning forest as (index, index, weight) edges; V - 1 of them when the graph is connected.
+    template <typename TKey>
+    const std::vector<WeightedEdge>& Run(const CsrGraph<TKey>& graph, MstAlgorithm algorithm = MstAlgorithm::Kruskal)
+    {
+        vertexCount = graph.GetVertexCount();
+        forest.clear();
+        components.Reset(vertexCount);
+
+        CollectEdges(graph);
+
+        if (algorithm == MstAlgorithm::FilterKruskal)
+            FilterKruskal(0, (int)edges.size());
+        else if (algorithm == MstAlgorithm::Boruvka)
+            RunBoruvka();
+        else
+            RunKruskal();
+
+        return forest;
+    }
+
+    int GetThreadCount() const
+    {
+        return pool.GetThreadCount();
+    }
+};
+
+
+inline long long GetTotalWeight(const std::vector<WeightedEdge>& edges)
+{
+    long long total = 0;
+
+    for (const WeightedEdge& edge : edges)
+        total += edge.weight;
+
+    return total;
+}
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <vector>
+
+
+
+// Addressable min-priority queues over vertex ids 0..n-1 with int keys.
+// All of them share one interface so DijkstraEngine can take any of them as a template parameter:
+//   Reset(n)          - empty the queue and make ids below n valid; buffers are kept between runs
+//   IsEmpty()
+//   Contains(vertex)
+//   PeekMinKey()
+//   Push(vertex, key) - insert, or decrease the key if the vertex is already queued with a larger one
+//   PopMin(vertex, key)
+
+
+template <int Arity>
+class DAryHeap {
+private:
+
+    std::vector<int> heap;
+    std::vector<int> keys;
+    std::vector<int> positions;
+
+    void Place(int slot, int vertex, int key)
+    {
+        heap[slot] = vertex;
+        keys[slot] = key;
+        positions[vertex] = slot;
+    }
+
+    void SiftUp(int slot)
+    {
+        int vertex = heap[slot];
+        int key = keys[slot];
+
+        while (slot > 0)
+        {
+            int parent = (slot - 1) / Arity;
+
+            if (keys[parent] <= key)
+                break;
+
+            Place(slot, heap[parent], keys[parent]);
+            slot = parent;
+        }
+
+        Place(slot, vertex, key);
+    }
+
+    void SiftDown(int slot)
+    {
+        int size = (int)heap.size();
+        int vertex = heap[slot];
+        int key = keys[slot];
+
+        while (true)
+        {
+            int first = slot * Arity + 1;
+
+            if (first >= size)
+                break;
+
+            int last = first + Arity < size ? first + Arity : size;
+            int best = first;
+
+            for (int child = first + 1; child < last; child++)
+                if (keys[child] < keys[best])
+                    best = child;
+
+            if (keys[best] >= key)
+                break;
+
+            Place(slot, heap[best], keys[best]);
+            slot = best;
+        }
+
+        Place(slot, vertex, key);
+    }
+
+public:
+
+    void Reset(int vertexCount)
+    {
+        for (int vertex : heap)
+            positions[vertex] = -1;
+
+        heap.clear();
+        keys.clear();
+
+        if ((int)positions.size() < vertexCount)
+            positions.resize(vertexCount, -1);
+    }
+
+    bool IsEmpty() const
+    {
+        return heap.empty();
+    }
+
+    bool Contains(int vertex) const
+    {
+        return positions[vertex] != -1;
+    }
+
+    int PeekMinKey() const
+    {
+        return keys[0];
+    }
+
+    void Push(int vertex, int key)
+    {
+        int slot = positions[vertex];
+
+        if (slot == -1)
+        {
+            heap.push_back(vertex);
+            keys.push_back(key);
+            SiftUp((int)heap.size() - 1);
+        }
+        else if (key < keys[slot])
+        {
+            keys[slot] = key;
+            SiftUp(slot);
+        }
+    }
+
+    void PopMin(int& vertex, int& key)
+    {
+        vertex = heap[0];
+        key = keys[0];
+        positions[vertex] = -1;
+
+        int lastVertex = heap.back();
+        int lastKey = keys.back();
+        heap.pop_back();
+        keys.pop_back();
+
+        if (!heap.empty())
+        {
+            Place(0, lastVertex, lastKey);
+            SiftDown(0);
+        }
+    }
+};
+
+using BinaryHeap = DAryHeap<2>;
+using QuaternaryHeap = DAryHeap<4>;
+
+
+// Pairing heap with O(1) insert and decrease-key; nodes are the vertex ids themselves.
+class PairingHeap {
+private:
+
+    std::vector<int> keys;
+    std::vector<int> child;
+    std::vector<int> next;
+    std::vector<int> prev;      // parent for the leftmost child, left sibling otherwise
+    std::vector<char> queued;
+    std::vector<int> scratch;
+    int root = -1;
+
+    int Link(int first, int second)
+    {
+        if (keys[second] < keys[first])
+        {
+            int temp = first;
+            first = second;
+            second = temp;
+        }
+
+        next[second] = child[first];
+
+        if (child[first] != -1)
+            prev[child[first]] = second;
+
+        prev[second] = first;
+        child[first] = second;
+
+        return first;
+    }
+
+    void Detach(int vertex)
+    {
+        int before = prev[vertex];
+
+        if (child[before] == vertex)
+            child[before] = next[vertex];
+        else
+            next[before] = next[vertex];
+
+        if (next[vertex] != -1)
+            prev[next[vertex]] = before;
+
+        next[vertex] = -1;
+        prev[vertex] = -1;
+    }
+
+public:
+
+    void Reset(int vertexCount)
+    {
+        if (root != -1)
+        {
+            scratch.clear();
+            scratch.push_back(root);
+
+            while (!scratch.empty())
+            {
+                int vertex = scratch.back();
+                scratch.pop_back();
+
+                for (int c = child[vertex]; c != -1; c = next[c])
+                    scratch.push_back(c);
+
+                queued[vertex] = false;
+                child[vertex] = next[vertex] = prev[vertex] = -1;
+            }
+
+            root = -1;
+        }
+
+        if ((int)keys.size() < vertexCount)
+        {
+            keys.resize(vertexCount, 0);
+            child.resize(vertexCount, -1);
+            next.resize(vertexCount, -1);
+            prev.resize(vertexCount, -1);
+            queued.resize(vertexCount, false);
+        }
+    }
+
+    bool IsEmpty() const
+    {
+        return root == -1;
+    }
+
+    bool Contains(int vertex) const
+    {
+        return queued[vertex];
+    }
+
+    int PeekMinKey() const
+    {
+        return keys[root];
+    }
+
+    void Push(int vertex, int key)
+    {
+        if (!queued[vertex])
+        {
+            queued[vertex] = true;
+            keys[vertex] = key;
+            root = root == -1 ? vertex : Link(root, vertex);
+            return;
+        }
+
+        if (key >= keys[vertex])
+            return;
+
+        keys[vertex] = key;
+
+        if (vertex != root)
+        {
+            Detach(vertex);
+            root = Link(root, vertex);
+        }
+    }
+
+    void PopMin(int& vertex, int& key)
+    {
+        vertex = root;
+        key = keys[root];
+        queued[root] = false;
+
+        scratch.clear();
+
+        for (int c = child[root]; c != -1;)
+        {
+            int following = next[c];
+            next[c] = prev[c] = -1;
+            scratch.push_back(c);
+            c = following;
+        }
+
+        child[root] = -1;
+
+        if (scratch.empty())
+        {
+            root = -1;
+            return;
+        }
+
+        // two-pass pairing: merge neighbours left to right, then fold the pairs right to left
+        int pairs = 0;
+
+        for (int i = 0; i + 1 < (int)scratch.size(); i += 2)
+            scratch[pairs++] = Link(scratch[i], scratch[i + 1]);
+
+        if (scratch.size() % 2 == 1)
+            scratch[pairs++] = scratch.back();
+
+        int merged = scratch[pairs - 1];
+
+        for (int i = pairs - 2; i >= 0; i--)
+            merged = Link(scratch[i], merged);
+
+        prev[merged] = -1;
+        root = merged;
+    }
+};
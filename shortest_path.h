@@ -0,0 +1,162 @@
+#pragma once
+
+#include "csr_graph.h"
+#include "priority_queues.h"
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+
+
+template <typename TKey>
+class ShortestPathResult {
+public:
+
+    int distance = std::numeric_limits<int>::max();
+    std::vector<TKey> path;     // source ... target, empty if the target is unreachable
+};
+
+
+// Point-to-point queries with bidirectional Dijkstra on a CsrGraph.
+// Both searches stop as soon as the sum of their queue minimums reaches the best meeting distance.
+// Scratch arrays are invalidated with a per-query stamp instead of being cleared, and the result
+// buffer is reused, so after the first query nothing is allocated.
+template <typename TKey, typename TQueue = BinaryHeap>
+class ShortestPathQuery {
+private:
+
+    const CsrGraph<TKey>& graph;
+    TQueue queues[2];
+    std::vector<int> distances[2];
+    std::vector<int> parents[2];
+    std::vector<unsigned> reached[2];
+    std::vector<unsigned> settled[2];
+    unsigned stamp = 0;
+    int settledCount = 0;
+    ShortestPathResult<TKey> result;
+
+    void NextStamp()
+    {
+        stamp++;
+
+        if (stamp == 0)
+        {
+            for (int side = 0; side < 2; side++)
+            {
+                std::fill(reached[side].begin(), reached[side].end(), 0);
+                std::fill(settled[side].begin(), settled[side].end(), 0);
+            }
+
+            stamp = 1;
+        }
+    }
+
+    void Reach(int side, int vertex, int distance, int parent)
+    {
+        distances[side][vertex] = distance;
+        parents[side][vertex] = parent;
+        reached[side][vertex] = stamp;
+        queues[side].Push(vertex, distance);
+    }
+
+    void BuildPath(int meeting)
+    {
+        for (int vertex = meeting; vertex != -1; vertex = parents[0][vertex])
+            result.path.push_back(graph.GetVertex(vertex));
+
+        std::reverse(result.path.begin(), result.path.end());
+
+        for (int vertex = parents[1][meeting]; vertex != -1; vertex = parents[1][vertex])
+            result.path.push_back(graph.GetVertex(vertex));
+    }
+
+public:
+
+    explicit ShortestPathQuery(const CsrGraph<TKey>& graph) : graph(graph)
+    {
+        int count = graph.GetVertexCount();
+
+        for (int side = 0; side < 2; side++)
+        {
+            distances[side].resize(count);
+            parents[side].resize(count);
+            reached[side].resize(count, 0);
+            settled[side].resize(count, 0);
+        }
+    }
+
+    const ShortestPathResult<TKey>& ShortestPath(TKey source, TKey target)
+    {
+        int sourceIndex = graph.GetIndex(source);
+        int targetIndex = graph.GetIndex(target);
+
+        if (sourceIndex == -1 || targetIndex == -1)
+            throw std::invalid_argument("Vertex not found in the graph.");
+
+        NextStamp();
+        settledCount = 0;
+        result.distance = std::numeric_limits<int>::max();
+        result.path.clear();
+
+        queues[0].Reset(graph.GetVertexCount());
+        queues[1].Reset(graph.GetVertexCount());
+        Reach(0, sourceIndex, 0, -1);
+        Reach(1, targetIndex, 0, -1);
+
+        int best = sourceIndex == targetIndex ? 0 : std::numeric_limits<int>::max();
+        int meeting = sourceIndex == targetIndex ? sourceIndex : -1;
+
+        while (!queues[0].IsEmpty() && !queues[1].IsEmpty())
+        {
+            int forwardMin = queues[0].PeekMinKey();
+            int backwardMin = queues[1].PeekMinKey();
+
+            if (best != std::numeric_limits<int>::max() && (long long)forwardMin + backwardMin >= best)
+                break;
+
+            int side = forwardMin <= backwardMin ? 0 : 1;
+            int other = 1 - side;
+            int vertex;
+            int distance;
+            queues[side].PopMin(vertex, distance);
+
+            settled[side][vertex] = stamp;
+            settledCount++;
+
+            for (int p = graph.NeighborsBegin(vertex); p < graph.NeighborsEnd(vertex); p++)
+            {
+                int neighbor = graph.GetNeighbor(p);
+                int candidate = distance + graph.GetWeight(p);
+
+                if (settled[side][neighbor] == stamp)
+                    continue;
+
+                if (reached[side][neighbor] != stamp || candidate < distances[side][neighbor])
+                    Reach(side, neighbor, candidate, vertex);
+
+                if (reached[other][neighbor] == stamp &&
+                    (long long)distances[side][neighbor] + distances[other][neighbor] < best)
+                {
+                    best = distances[side][neighbor] + distances[other][neighbor];
+                    meeting = neighbor;
+                }
+            }
+        }
+
+        if (meeting != -1)
+        {
+            result.distance = best;
+            BuildPath(meeting);
+        }
+
+        return result;
+    }
+
+    // Vertices settled by both searches during the last query.
+    int GetSettledCount() const
+    {
+        return settledCount;
+    }
+};
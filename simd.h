@@ -0,0 +1,112 @@
+#pragma once
+
+// Runtime SIMD dispatch for the vectorized kernels.
+// Kernels are compiled for every level with target attributes and picked once per call from the CPU flags,
+// so the binary still runs on machines without AVX2. Other compilers and architectures get the scalar code.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define GRAPH_SIMD_X86 1
+#define GRAPH_TARGET_SSE2 __attribute__((target("sse2")))
+#define GRAPH_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+#include <new>
+#include <cstddef>
+
+
+
+enum class SimdLevel {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+inline SimdLevel DetectSimdLevel()
+{
+#ifdef GRAPH_SIMD_X86
+    if (__builtin_cpu_supports("avx2"))
+        return SimdLevel::Avx2;
+
+    if (__builtin_cpu_supports("sse2"))
+        return SimdLevel::Sse2;
+#endif
+
+    return SimdLevel::Scalar;
+}
+
+// Clamps a requested level to what the CPU supports.
+inline SimdLevel LimitSimdLevel(SimdLevel requested)
+{
+    SimdLevel supported = DetectSimdLevel();
+
+    return (int)requested < (int)supported ? requested : supported;
+}
+
+inline const char* GetSimdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+        case SimdLevel::Avx2:
+            return "AVX2";
+        case SimdLevel::Sse2:
+            return "SSE2";
+        default:
+            return "scalar";
+    }
+}
+
+
+// Growable int buffer aligned for full-width vector loads. Resize keeps the memory when it is large enough.
+class AlignedIntBuffer {
+private:
+
+    static constexpr std::size_t alignment = 64;
+
+    int* data = nullptr;
+    int capacity = 0;
+
+public:
+
+    AlignedIntBuffer() = default;
+
+    AlignedIntBuffer(const AlignedIntBuffer&) = delete;
+    AlignedIntBuffer& operator=(const AlignedIntBuffer&) = delete;
+
+    ~AlignedIntBuffer()
+    {
+        if (data)
+            ::operator delete[](data, std::align_val_t(alignment));
+    }
+
+    void Resize(int size)
+    {
+        if (size <= capacity)
+            return;
+
+        if (data)
+            ::operator delete[](data, std::align_val_t(alignment));
+
+        data = static_cast<int*>(::operator new[](sizeof(int) * (std::size_t)size, std::align_val_t(alignment)));
+        capacity = size;
+    }
+
+    int* GetData()
+    {
+        return data;
+    }
+
+    const int* GetData() const
+    {
+        return data;
+    }
+
+    int& operator[](int index)
+    {
+        return data[index];
+    }
+
+    int operator[](int index) const
+    {
+        return data[index];
+    }
+};
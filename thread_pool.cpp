@@ -0,0 +1,120 @@
+#include "thread_pool.h"
+
+#include <atomic>
+#include <algorithm>
+
+
+
+ThreadPool::ThreadPool(int threadCount) : generation(0), pending(0), stopping(false)
+{
+    if (threadCount <= 0)
+        threadCount = GetDefaultThreadCount();
+
+    for (int i = 1; i < threadCount; i++)
+        workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    wake.notify_all();
+
+    for (auto& worker : workers)
+        worker.join();
+}
+
+int ThreadPool::GetThreadCount() const
+{
+    return (int)workers.size() + 1;
+}
+
+int ThreadPool::GetDefaultThreadCount()
+{
+    int count = (int)std::thread::hardware_concurrency();
+
+    return count > 0 ? count : 1;
+}
+
+void ThreadPool::WorkerLoop(int threadIndex)
+{
+    unsigned long long seen = 0;
+
+    while (true)
+    {
+        std::function<void(int)> current;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&]() { return stopping || generation != seen; });
+
+            if (stopping)
+                return;
+
+            seen = generation;
+            current = task;
+        }
+
+        current(threadIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending--;
+        }
+
+        finished.notify_one();
+    }
+}
+
+void ThreadPool::Run(const std::function<void(int)>& function)
+{
+    if (workers.empty())
+    {
+        function(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = function;
+        pending = (int)workers.size();
+        generation++;
+    }
+
+    wake.notify_all();
+    function(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&]() { return pending == 0; });
+}
+
+void ThreadPool::ParallelFor(int count, int chunkSize, const std::function<void(int, int, int)>& function)
+{
+    if (count <= 0)
+        return;
+
+    chunkSize = std::max(1, chunkSize);
+
+    if (workers.empty() || count <= chunkSize)
+    {
+        function(0, 0, count);
+        return;
+    }
+
+    std::atomic<int> next(0);
+
+    Run([&](int threadIndex) {
+        while (true)
+        {
+            int begin = next.fetch_add(chunkSize);
+
+            if (begin >= count)
+                break;
+
+            function(threadIndex, begin, std::min(count, begin + chunkSize));
+        }
+    });
+}
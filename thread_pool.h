@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+
+
+// Fixed set of worker threads shared by the parallel algorithms.
+// The calling thread takes part in every job as thread 0, so ThreadPool(1) runs everything inline.
+class ThreadPool {
+private:
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::function<void(int)> task;
+    unsigned long long generation;
+    int pending;
+    bool stopping;
+
+    void WorkerLoop(int threadIndex);
+
+public:
+
+    explicit ThreadPool(int threadCount = 0);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+    int GetThreadCount() const;
+
+    // Calls function(threadIndex) once on every thread and waits for all of them.
+    void Run(const std::function<void(int)>& function);
+
+    // Hands out [0, count) in chunks of chunkSize; function(threadIndex, begin, end) is called per chunk.
+    void ParallelFor(int count, int chunkSize, const std::function<void(int, int, int)>& function);
+
+    static int GetDefaultThreadCount();
+};
@@ -1,358 +1,637 @@
-#pragma once
-
-#include "hash_table.h"
-#include "dynamic_array.h"
-
-#include <optional>
-#include <queue>
-#include <unordered_map>
-#include <limits>
-#include <vector>
-#include <algorithm>
-#include <functional>
-
-
-
-class Edge {
-public:
-
-    int vertex;
-    int weight;
-
-    Edge(int v = 0, int w = 0) : vertex(v), weight(w) {}
-
-    bool operator==(const Edge& other) const
-    {
-        return vertex == other.vertex && weight == other.weight;
-    }
-
-    bool operator!=(const Edge& other) const
-    {
-        return !(*this == other);
-    }
-};
-
-
-template <typename TKey>
-class UndirectedGraph {
-private:
-
-    int vertexCount;
-    DynamicArray<TKey> vertexes;
-    HashTable<TKey, DynamicArray<Edge>> adjacencyList;
-
-public:
-
-    UndirectedGraph(int vertexCount = 0)
-    {
-        if (vertexCount < 0)
-            vertexCount = 0;
-
-        this->vertexCount = vertexCount;
-        adjacencyList = HashTable<TKey, DynamicArray<Edge>>(vertexCount);
-        vertexes = DynamicArray<TKey>(0);
-    }
-
-    void AddEdge(TKey vertex1, TKey vertex2, int weight)
-    {
-        if (adjacencyList.GetValue(vertex1) == std::nullopt || adjacencyList.GetValue(vertex2) == std::nullopt)
-            return;
-
-        for (int i = 0; i < adjacencyList.GetValue(vertex1).value().GetLength(); i++)
-            if (adjacencyList.GetValue(vertex1).value()[i].vertex == vertex2)
-                return;
-
-        DynamicArray<Edge> array1 = adjacencyList.GetValue(vertex1).value();
-        array1.Append(Edge(vertex2, weight));
-        DynamicArray<Edge> array2 = adjacencyList.GetValue(vertex2).value();
-        array2.Append(Edge(vertex1, weight));
-        adjacencyList.Add(vertex1, array1);
-        adjacencyList.Add(vertex2, array2);
-    }
-
-    void AddVertex(TKey vertex)
-    {
-        for (int i = 0; i < vertexes.GetLength(); i++)
-            if (vertexes[i] == vertex)
-                return;
-
-        DynamicArray<Edge> newAdjacencyList;
-
-        adjacencyList.Add(vertex, newAdjacencyList);
-        vertexes.Append(vertex);
-        vertexCount++;
-    }
-
-    int GetVertexCount() const
-    {
-        return vertexCount;
-    }
-
-    TKey GetVertex(int index) const
-    {
-        if (index < 0 || index > vertexCount)
-            return TKey();
-
-        return vertexes[index];
-    }
-
-    DynamicArray<Edge> GetAdjacentVertices(TKey vertex) const
-    {
-        auto result = adjacencyList.GetValue(vertex);
-
-        if (result.has_value())
-            return result.value();
-        else
-            return DynamicArray<Edge>();
-    }
-
-    bool AreConnected(TKey vertex1, TKey vertex2) const
-    {
-        if (adjacencyList.GetValue(vertex1) == std::nullopt || adjacencyList.GetValue(vertex2) == std::nullopt)
-            return false;
-
-        DynamicArray<Edge> adjacentVertices = GetAdjacentVertices(vertex1);
-
-        for (int i = 0; i < adjacentVertices.GetLength(); i++)
-            if (adjacentVertices[i].vertex == vertex2)
-                return true;
-
-        return false;
-    }
-
-    void RemoveEdge(TKey vertex1, TKey vertex2)
-    {
-        if (adjacencyList.GetValue(vertex1) == std::nullopt || adjacencyList.GetValue(vertex2) == std::nullopt)
-            return;
-
-        DynamicArray<Edge> array1 = adjacencyList.GetValue(vertex1).value();
-        for (int i = 0; i < array1.GetLength(); i++)
-        {
-            if (array1[i].vertex == vertex2)
-            {
-                array1.Remove(i);
-                break;
-            }
-        }
-
-        adjacencyList.Add(vertex1, array1);
-
-        DynamicArray<Edge> array2 = adjacencyList.GetValue(vertex2).value();
-
-        for (int i = 0; i < array2.GetLength(); i++)
-        {
-            if (array2[i].vertex == vertex1)
-            {
-                array2.Remove(i);
-                break;
-            }
-        }
-
-        adjacencyList.Add(vertex2, array2);
-    }
-
-    void RemoveVertex(TKey vertex)
-    {
-        if (adjacencyList.GetValue(vertex) == std::nullopt)
-            return;
-
-        DynamicArray<Edge> adjacentEdges = GetAdjacentVertices(vertex);
-
-        for (int i = 0; i < vertexes.GetLength(); i++)
-        {
-            if (vertexes[i] == vertex)
-            {
-                vertexes.Remove(i);
-                break;
-            }
-        }
-
-        for (int i = 0; i < adjacentEdges.GetLength(); i++)
-        {
-            TKey adjacentVertex = adjacentEdges[i].vertex;
-            RemoveEdge(vertex, adjacentVertex);
-        }
-
-        adjacencyList.Remove(vertex);
-        vertexCount--;
-    }
-
-    DynamicArray<int> ColorGraph()
-    {
-        DynamicArray<int> colors(vertexes.GetLength());
-
-        for (int i = 0; i < vertexes.GetLength(); i++)
-            colors.Set(i, -1);
-
-        for (int i = 0; i < vertexes.GetLength(); i++)
-        {
-            TKey currentVertex = vertexes[i];
-            DynamicArray<bool> availableColors(vertexes.GetLength());
-
-            for (int j = 0; j < availableColors.GetLength(); j++)
-                availableColors.Set(j, true);
-
-            DynamicArray<Edge> adjacentEdges = GetAdjacentVertices(currentVertex);
-
-            for (int j = 0; j < adjacentEdges.GetLength(); j++)
-            {
-                TKey neighbor = adjacentEdges[j].vertex;
-
-                for (int k = 0; k < vertexes.GetLength(); k++)
-                {
-                    if (vertexes[k] == neighbor && colors.GetElement(k) != -1)
-                    {
-                        availableColors.Set(colors.GetElement(k), false);
-                        break;
-                    }
-                }
-            }
-
-            for (int color = 0; color < availableColors.GetLength(); color++)
-            {
-                if (availableColors.GetElement(color))
-                {
-                    colors.Set(i, color);
-                    break;
-                }
-            }
-        }
-
-        return colors;
-    }
-
-    DynamicArray<int> DiijkstaAlgorithm(TKey startVertex)
-    {
-        DynamicArray<int> distances(vertexes.GetLength());
-        DynamicArray<bool> visited(vertexes.GetLength());
-        std::unordered_map<TKey, int> vertexIndexMap;
-
-        for (int i = 0; i < vertexes.GetLength(); i++)
-        {
-            distances.Set(i, std::numeric_limits<int>::max());
-            visited.Set(i, false);
-            vertexIndexMap[vertexes[i]] = i;
-        }
-
-        auto startIt = vertexIndexMap.find(startVertex);
-        if (startIt == vertexIndexMap.end())
-        {
-            throw std::invalid_argument("Start vertex not found in the graph.");
-        }
-        int startIndex = startIt->second;
-        distances.Set(startIndex, 0);
-
-        for (int i = 0; i < vertexes.GetLength(); i++)
-        {
-            int minDistance = std::numeric_limits<int>::max();
-            int minIndex = -1;
-
-            for (int j = 0; j < vertexes.GetLength(); j++)
-            {
-                if (!visited.GetElement(j) && distances.GetElement(j) < minDistance)
-                {
-                    minDistance = distances.GetElement(j);
-                    minIndex = j;
-                }
-            }
-
-            if (minIndex == -1) break;
-
-            visited.Set(minIndex, true);
-            TKey minVertex = vertexes[minIndex];
-            DynamicArray<Edge> adjacentEdges = GetAdjacentVertices(minVertex);
-
-            for (int j = 0; j < adjacentEdges.GetLength(); j++)
-            {
-                TKey neighbor = adjacentEdges[j].vertex;
-                int weight = adjacentEdges[j].weight;
-
-                auto neighborIt = vertexIndexMap.find(neighbor);
-                if (neighborIt != vertexIndexMap.end())
-                {
-                    int neighborIndex = neighborIt->second;
-
-                    if (!visited.GetElement(neighborIndex) &&
-                        distances.GetElement(minIndex) + weight < distances.GetElement(neighborIndex))
-                    {
-                        distances.Set(neighborIndex, distances.GetElement(minIndex) + weight);
-                    }
-                }
-            }
-        }
-
-        return distances;
-    }
-
-    DynamicArray<Edge> FindMinimumSpanningTreeKruskal()
-    {
-        DynamicArray<Edge> mst;
-        if (vertexes.GetLength() == 0)
-            return mst;
-
-        std::vector<std::tuple<int, int, int>> edges;
-
-        for (int i = 0; i < vertexes.GetLength(); i++)
-        {
-            TKey u = vertexes[i];
-            DynamicArray<Edge> adjacentEdges = GetAdjacentVertices(u);
-
-            for (int j = 0; j < adjacentEdges.GetLength(); j++)
-            {
-                TKey v = adjacentEdges[j].vertex;
-                int weight = adjacentEdges[j].weight;
-
-                if (u < v)
-                    edges.push_back({weight, u, v});
-            }
-        }
-
-        std::sort(edges.begin(), edges.end());
-
-        std::unordered_map<TKey, TKey> parent;
-        std::unordered_map<TKey, int> rank;
-
-        std::function<TKey(TKey)> Find = [&](TKey vertex) -> TKey {
-            if (parent[vertex] != vertex)
-                parent[vertex] = Find(parent[vertex]);
-            return parent[vertex];
-        };
-
-        auto Union = [&](TKey root1, TKey root2) {
-            if (rank[root1] < rank[root2])
-                parent[root1] = root2;
-            else if (rank[root1] > rank[root2])
-                parent[root2] = root1;
-            else
-            {
-                parent[root2] = root1;
-                rank[root1]++;
-            }
-        };
-
-        for (int i = 0; i < vertexes.GetLength(); i++)
-        {
-            TKey vertex = vertexes[i];
-            parent[vertex] = vertex;
-            rank[vertex] = 0;
-        }
-
-        for (const auto& edge : edges)
-        {
-            int weight = std::get<0>(edge);
-            TKey u = std::get<1>(edge);
-            TKey v = std::get<2>(edge);
-
-            TKey rootU = Find(u);
-            TKey rootV = Find(v);
-
-            if (rootU != rootV)
-            {
-                mst.Append(Edge(v, weight));
-                Union(rootU, rootV);
-            }
-        }
-
-        return mst;
-    }
-};
+#pragma once
+
+#include "dynamic_array.h"
+#include "edge.h"
+#include "csr_graph.h"
+#include "dijkstra_engine.h"
+#include "graph_observer.h"
+#include "graph_coloring.h"
+#include "vertex_interner.h"
+#include "thread_pool.h"
+
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <span>
+#include <concepts>
+
+
+
+// Versions are drawn from one process-wide counter, so two graphs never report the same version
+// and a (vertex, version) pair identifies a graph state even after the graph is moved or replaced.
+inline unsigned long long NextGraphVersion()
+{
+    static std::atomic<unsigned long long> counter(0);
+
+    return ++counter;
+}
+
+
+// Neighbor as seen through NeighborRange: the key refers into the graph, the id is the interned one.
+template <typename TKey>
+struct Neighbor {
+    const TKey& vertex;
+    int weight;
+    uint32_t id;
+};
+
+
+// Borrowed view of one adjacency list; nothing is copied. It is invalidated by any mutation of the graph.
+template <typename TKey>
+class NeighborRange {
+private:
+
+    const Edge* first;
+    const Edge* last;
+    const VertexInterner<TKey>* interner;
+
+public:
+
+    class Iterator {
+    private:
+
+        const Edge* current;
+        const VertexInterner<TKey>* interner;
+
+    public:
+
+        Iterator(const Edge* current, const VertexInterner<TKey>* interner) : current(current), interner(interner) {}
+
+        Neighbor<TKey> operator*() const
+        {
+            return Neighbor<TKey>{interner->GetKey(current->vertex), current->weight, (uint32_t)current->vertex};
+        }
+
+        Iterator& operator++()
+        {
+            current++;
+
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return current == other.current;
+        }
+
+        bool operator!=(const Iterator& other) const
+        {
+            return current != other.current;
+        }
+    };
+
+    NeighborRange(const Edge* first, const Edge* last, const VertexInterner<TKey>* interner)
+            : first(first), last(last), interner(interner) {}
+
+    Iterator begin() const
+    {
+        return Iterator(first, interner);
+    }
+
+    Iterator end() const
+    {
+        return Iterator(last, interner);
+    }
+
+    int GetLength() const
+    {
+        return (int)(last - first);
+    }
+
+    bool IsEmpty() const
+    {
+        return first == last;
+    }
+
+    Neighbor<TKey> operator[](int index) const
+    {
+        return *Iterator(first + index, interner);
+    }
+};
+
+
+// CSR snapshot of one graph version, for the const queries that run on the CsrGraph engines: repeated queries
+// on an unchanged graph freeze it once. Get is safe from several threads. A copy starts empty, so copied graphs
+// never share a snapshot.
+template <typename TKey>
+class SnapshotCache {
+private:
+
+    mutable std::mutex mutex;
+    mutable unsigned long long version = 0;
+    mutable std::shared_ptr<const CsrGraph<TKey>> graph;
+
+public:
+
+    SnapshotCache() = default;
+
+    SnapshotCache(const SnapshotCache&) {}
+
+    SnapshotCache& operator=(const SnapshotCache&)
+    {
+        std::lock_guard lock(mutex);
+        graph.reset();
+
+        return *this;
+    }
+
+    // The snapshot stays alive for the caller even if a later version replaces it here.
+    template <typename TFreeze>
+    std::shared_ptr<const CsrGraph<TKey>> Get(unsigned long long currentVersion, TFreeze freeze) const
+    {
+        std::lock_guard lock(mutex);
+
+        if (!graph || version != currentVersion)
+        {
+            graph = std::make_shared<const CsrGraph<TKey>>(freeze());
+            version = currentVersion;
+        }
+
+        return graph;
+    }
+};
+
+
+template <typename TKey>
+class UndirectedGraph {
+private:
+
+    // Adjacency lists store interned vertex ids (Edge::vertex is an id, not a key); order holds the ids in
+    // GetVertex order and positions maps an id back to its place there, -1 for free ids.
+    int vertexCount;
+    unsigned long long version = NextGraphVersion();
+    VertexInterner<TKey> interner;
+    DynamicArray<DynamicArray<Edge>> adjacency;
+    std::vector<uint32_t> order;
+    std::vector<int> positions;
+    GraphObserverList<TKey> observers;
+    SnapshotCache<TKey> snapshot;
+
+    static constexpr std::size_t edgeChunkSize = 65536;
+
+    std::shared_ptr<const CsrGraph<TKey>> GetSnapshot() const
+    {
+        return snapshot.Get(version, [this]() { return Freeze(); });
+    }
+
+    int FindEdge(uint32_t from, uint32_t to) const
+    {
+        const DynamicArray<Edge>& edges = adjacency[from];
+
+        // edges are unique, so the scan can run backwards; RemoveVertex then finds each edge immediately
+        for (int i = edges.GetLength() - 1; i >= 0; i--)
+            if ((uint32_t)edges[i].vertex == to)
+                return i;
+
+        return -1;
+    }
+
+    // Interns the vertex and appends it to the GetVertex order if it is new; no version bump or notification.
+    uint32_t InsertVertex(const TKey& vertex)
+    {
+        int count = interner.GetCount();
+        uint32_t id = interner.Intern(vertex);
+
+        if (interner.GetCount() == count)
+            return id;
+
+        if (id == (uint32_t)adjacency.GetLength())
+        {
+            adjacency.EmplaceBack();
+            positions.push_back(-1);
+        }
+
+        positions[id] = (int)order.size();
+        order.push_back(id);
+        vertexCount++;
+
+        return id;
+    }
+
+public:
+
+    // The argument only reserves room for that many vertices.
+    UndirectedGraph(int vertexCount = 0)
+    {
+        this->vertexCount = 0;
+
+        if (vertexCount > 0)
+        {
+            interner.Reserve(vertexCount);
+            adjacency.Reserve(vertexCount);
+            order.reserve(vertexCount);
+            positions.reserve(vertexCount);
+        }
+    }
+
+    void AddEdge(TKey vertex1, TKey vertex2, int weight)
+    {
+        uint32_t id1 = interner.Find(vertex1);
+        uint32_t id2 = interner.Find(vertex2);
+
+        if (id1 == VertexInterner<TKey>::invalidId || id2 == VertexInterner<TKey>::invalidId)
+            return;
+
+        if (FindEdge(id1, id2) != -1)
+            return;
+
+        adjacency[id1].EmplaceBack((int)id2, weight);
+
+        // a self-loop is stored once
+        if (id1 != id2)
+            adjacency[id2].EmplaceBack((int)id1, weight);
+
+        version = NextGraphVersion();
+
+        observers.Notify([&](IGraphObserver<TKey>* observer) { observer->OnEdgeAdded(vertex1, vertex2, weight); });
+    }
+
+    void AddVertex(TKey vertex)
+    {
+        if (interner.Find(vertex) != VertexInterner<TKey>::invalidId)
+            return;
+
+        InsertVertex(vertex);
+        version = NextGraphVersion();
+
+        observers.Notify([&](IGraphObserver<TKey>* observer) { observer->OnVertexAdded(vertex); });
+    }
+
+    // The observer is not owned and has to unsubscribe before it is destroyed.
+    void Subscribe(IGraphObserver<TKey>* observer)
+    {
+        observers.Subscribe(observer);
+    }
+
+    void Unsubscribe(IGraphObserver<TKey>* observer)
+    {
+        observers.Unsubscribe(observer);
+    }
+
+    int GetVertexCount() const
+    {
+        return vertexCount;
+    }
+
+    // Grows after AddEdge, RemoveEdge, AddVertex and RemoveVertex; calls rejected for unknown or duplicate
+    // vertices leave it unchanged.
+    unsigned long long GetVersion() const
+    {
+        return version;
+    }
+
+    TKey GetVertex(int index) const
+    {
+        if (index < 0 || index >= vertexCount)
+            return TKey();
+
+        return interner.GetKey(order[index]);
+    }
+
+    // Interned id of the vertex, VertexInterner<TKey>::invalidId if it is not in the graph. Ids of removed
+    // vertices are reused, so an id is only meaningful together with GetVertexGeneration.
+    uint32_t GetVertexId(TKey vertex) const
+    {
+        return interner.Find(vertex);
+    }
+
+    TKey GetVertexById(uint32_t id) const
+    {
+        return interner.IsAlive(id) ? interner.GetKey(id) : TKey();
+    }
+
+    uint32_t GetVertexGeneration(uint32_t id) const
+    {
+        return interner.GetGeneration(id);
+    }
+
+    // Length of the id range; ids are below it and at most GetVertexCount() + free ids.
+    int GetIdCapacity() const
+    {
+        return interner.GetCapacity();
+    }
+
+    // Borrows the adjacency list of the vertex; an unknown vertex has no neighbors.
+    NeighborRange<TKey> Neighbors(TKey vertex) const
+    {
+        uint32_t id = interner.Find(vertex);
+
+        if (id == VertexInterner<TKey>::invalidId)
+            return NeighborRange<TKey>(nullptr, nullptr, &interner);
+
+        const DynamicArray<Edge>& edges = adjacency[id];
+
+        if (edges.GetLength() == 0)
+            return NeighborRange<TKey>(nullptr, nullptr, &interner);
+
+        return NeighborRange<TKey>(&edges[0], &edges[0] + edges.GetLength(), &interner);
+    }
+
+    // Copy of the neighbors with keys in Edge::vertex; Neighbors avoids the copy.
+    DynamicArray<Edge> GetAdjacentVertices(TKey vertex) const
+    {
+        NeighborRange<TKey> neighbors = Neighbors(vertex);
+        DynamicArray<Edge> result(neighbors.GetLength());
+        int index = 0;
+
+        for (Neighbor<TKey> neighbor : neighbors)
+            result.Set(index++, Edge(neighbor.vertex, neighbor.weight));
+
+        return result;
+    }
+
+    bool AreConnected(TKey vertex1, TKey vertex2) const
+    {
+        uint32_t id1 = interner.Find(vertex1);
+        uint32_t id2 = interner.Find(vertex2);
+
+        if (id1 == VertexInterner<TKey>::invalidId || id2 == VertexInterner<TKey>::invalidId)
+            return false;
+
+        return FindEdge(id1, id2) != -1;
+    }
+
+    void RemoveEdge(TKey vertex1, TKey vertex2)
+    {
+        uint32_t id1 = interner.Find(vertex1);
+        uint32_t id2 = interner.Find(vertex2);
+
+        if (id1 == VertexInterner<TKey>::invalidId || id2 == VertexInterner<TKey>::invalidId)
+            return;
+
+        std::optional<int> removedWeight;
+        int index1 = FindEdge(id1, id2);
+
+        if (index1 != -1)
+        {
+            removedWeight = adjacency[id1][index1].weight;
+            adjacency[id1].Remove(index1);
+        }
+
+        int index2 = FindEdge(id2, id1);
+
+        if (index2 != -1)
+            adjacency[id2].Remove(index2);
+
+        if (index1 != -1 || index2 != -1)
+            version = NextGraphVersion();
+
+        if (removedWeight.has_value())
+            observers.Notify([&](IGraphObserver<TKey>* observer) { observer->OnEdgeRemoved(vertex1, vertex2, removedWeight.value()); });
+    }
+
+    void RemoveVertex(TKey vertex)
+    {
+        uint32_t id = interner.Find(vertex);
+
+        if (id == VertexInterner<TKey>::invalidId)
+            return;
+
+        // the last edge goes first, so nothing shifts in this list and it needs no copy
+        while (adjacency[id].GetLength() > 0)
+            RemoveEdge(vertex, interner.GetKey(adjacency[id].GetLastElement().vertex));
+
+        int position = positions[id];
+        order.erase(order.begin() + position);
+
+        for (int i = position; i < (int)order.size(); i++)
+            positions[order[i]] = i;
+
+        adjacency[id] = DynamicArray<Edge>();
+        positions[id] = -1;
+        interner.Release(vertex);
+        vertexCount--;
+        version = NextGraphVersion();
+
+        observers.Notify([&](IGraphObserver<TKey>* observer) { observer->OnVertexRemoved(vertex); });
+    }
+
+    // Bulk loader: adds every edge (and every endpoint that is missing) in one pass instead of one AddEdge call
+    // per edge. Degrees are counted first, so each adjacency list is allocated exactly once; the lists are then
+    // filled and deduplicated by sorting on the thread pool. As with AddEdge, an edge that is already present or
+    // repeated later in the list keeps its first weight. New neighbors follow the existing ones in id order.
+    // Observers get a single OnGraphReplaced instead of per-edge notifications. WeightedEdge endpoints are ints,
+    // so the keys have to be constructible from one.
+    void BuildFromEdges(std::span<const WeightedEdge> edges, int threadCount = 0) requires std::constructible_from<TKey, int>
+    {
+        std::size_t edgeCount = edges.size();
+
+        // a sort entry packs the edge position into its low 32 bits
+        if (edgeCount > std::numeric_limits<uint32_t>::max())
+            throw std::invalid_argument("Too many edges for a bulk load.");
+        std::vector<uint32_t> ids1(edgeCount);
+        std::vector<uint32_t> ids2(edgeCount);
+
+        for (std::size_t i = 0; i < edgeCount; i++)
+        {
+            ids1[i] = InsertVertex(TKey(edges[i].vertex1));
+            ids2[i] = InsertVertex(TKey(edges[i].vertex2));
+        }
+
+        ThreadPool pool(threadCount);
+        int capacity = interner.GetCapacity();
+        int chunkCount = (int)((edgeCount + edgeChunkSize - 1) / edgeChunkSize);
+        std::vector<std::size_t> offsets(capacity + 1, 0);
+
+        // locked increments stall on every cache miss, so a single thread counts without them
+        bool concurrent = pool.GetThreadCount() > 1;
+        auto claim = [concurrent](std::size_t& counter) {
+            return concurrent ? std::atomic_ref<std::size_t>(counter).fetch_add(1, std::memory_order_relaxed) : counter++;
+        };
+
+        // a self-loop is stored once, at its only endpoint
+        pool.ParallelFor(chunkCount, 1, [&](int thread, int begin, int end) {
+            for (std::size_t i = (std::size_t)begin * edgeChunkSize; i < std::min(edgeCount, (std::size_t)end * edgeChunkSize); i++)
+            {
+                claim(offsets[ids1[i] + 1]);
+
+                if (ids1[i] != ids2[i])
+                    claim(offsets[ids2[i] + 1]);
+            }
+        });
+
+        for (int id = 0; id < capacity; id++)
+            offsets[id + 1] += offsets[id];
+
+        // (neighbor, position in edges) pairs; sorting them groups duplicates with the earliest one in front
+        std::vector<uint64_t> entries(offsets[capacity]);
+        std::vector<std::size_t> cursors(offsets.begin(), offsets.end() - 1);
+
+        pool.ParallelFor(chunkCount, 1, [&](int thread, int begin, int end) {
+            for (std::size_t i = (std::size_t)begin * edgeChunkSize; i < std::min(edgeCount, (std::size_t)end * edgeChunkSize); i++)
+            {
+                entries[claim(cursors[ids1[i]])] = ((uint64_t)ids2[i] << 32) | i;
+
+                if (ids1[i] != ids2[i])
+                    entries[claim(cursors[ids2[i]])] = ((uint64_t)ids1[i] << 32) | i;
+            }
+        });
+
+        std::vector<std::vector<uint32_t>> existing(pool.GetThreadCount());
+
+        pool.ParallelFor(capacity, 256, [&](int thread, int begin, int end) {
+            std::vector<uint32_t>& present = existing[thread];
+
+            for (int id = begin; id < end; id++)
+            {
+                if (offsets[id] == offsets[id + 1])
+                    continue;
+
+                std::sort(entries.begin() + offsets[id], entries.begin() + offsets[id + 1]);
+
+                DynamicArray<Edge>& list = adjacency[id];
+                present.clear();
+
+                for (int i = 0; i < list.GetLength(); i++)
+                    present.push_back((uint32_t)list[i].vertex);
+
+                std::sort(present.begin(), present.end());
+                list.Reserve(list.GetLength() + (int)(offsets[id + 1] - offsets[id]));
+
+                uint32_t previous = VertexInterner<TKey>::invalidId;
+
+                for (std::size_t p = offsets[id]; p < offsets[id + 1]; p++)
+                {
+                    uint32_t neighbor = (uint32_t)(entries[p] >> 32);
+
+                    if (neighbor == previous)
+                        continue;
+
+                    previous = neighbor;
+
+                    if (!std::binary_search(present.begin(), present.end(), neighbor))
+                        list.EmplaceBack((int)neighbor, edges[entries[p] & 0xffffffffULL].weight);
+                }
+            }
+        });
+
+        version = NextGraphVersion();
+
+        observers.Notify([](IGraphObserver<TKey>* observer) { observer->OnGraphReplaced(); });
+    }
+
+    // Builds an immutable CSR snapshot for read-only algorithm runs.
+    // Adjacency lists are indexed by id, so translating them to GetVertex order needs no hashing at all.
+    CsrGraph<TKey> Freeze() const
+    {
+        int count = (int)order.size();
+        std::vector<TKey> keys(count);
+        std::vector<int> offsets(count + 1, 0);
+
+        for (int i = 0; i < count; i++)
+        {
+            keys[i] = interner.GetKey(order[i]);
+            offsets[i + 1] = offsets[i] + adjacency[order[i]].GetLength();
+        }
+
+        std::vector<int> neighbors(offsets[count]);
+        std::vector<int> weights(offsets[count]);
+
+        for (int i = 0; i < count; i++)
+        {
+            const DynamicArray<Edge>& edges = adjacency[order[i]];
+
+            for (int j = 0; j < edges.GetLength(); j++)
+            {
+                neighbors[offsets[i] + j] = positions[edges[j].vertex];
+                weights[offsets[i] + j] = edges[j].weight;
+            }
+        }
+
+        return CsrGraph<TKey>(std::move(keys), std::move(offsets), std::move(neighbors), std::move(weights));
+    }
+
+    // Greedy coloring on a CSR snapshot; Natural gives the classic first-fit result in GetVertex order.
+    DynamicArray<int> ColorGraph(ColoringOrder order = ColoringOrder::Natural) const
+    {
+        ColoringEngine engine;
+        const std::vector<int>& colors = engine.Run(*GetSnapshot(), order);
+        DynamicArray<int> result((int)colors.size());
+
+        for (int i = 0; i < (int)colors.size(); i++)
+            result.Set(i, colors[i]);
+
+        return result;
+    }
+
+    DynamicArray<int> DiijkstaAlgorithm(TKey startVertex)
+    {
+        uint32_t startId = interner.Find(startVertex);
+
+        if (startId == VertexInterner<TKey>::invalidId)
+            throw std::invalid_argument("Start vertex not found in the graph.");
+
+        int count = (int)order.size();
+        DynamicArray<int> distances(std::numeric_limits<int>::max(), count);
+        std::vector<char> visited(count, false);
+        distances.Set(positions[startId], 0);
+
+        for (int i = 0; i < count; i++)
+        {
+            int minDistance = std::numeric_limits<int>::max();
+            int minIndex = -1;
+
+            for (int j = 0; j < count; j++)
+            {
+                if (!visited[j] && distances[j] < minDistance)
+                {
+                    minDistance = distances[j];
+                    minIndex = j;
+                }
+            }
+
+            if (minIndex == -1) break;
+
+            visited[minIndex] = true;
+            const DynamicArray<Edge>& edges = adjacency[order[minIndex]];
+
+            for (int j = 0; j < edges.GetLength(); j++)
+            {
+                int neighborIndex = positions[edges[j].vertex];
+                int weight = edges[j].weight;
+
+                if (!visited[neighborIndex] && distances[minIndex] + weight < distances[neighborIndex])
+                    distances.Set(neighborIndex, distances[minIndex] + weight);
+            }
+        }
+
+        return distances;
+    }
+
+    // Heap-based Dijkstra for sparse graphs; TQueue is BinaryHeap, QuaternaryHeap or PairingHeap.
+    template <typename TQueue = BinaryHeap>
+    DynamicArray<int> HeapDiijkstaAlgorithm(TKey startVertex) const
+    {
+        uint32_t startId = interner.Find(startVertex);
+
+        if (startId == VertexInterner<TKey>::invalidId)
+            throw std::invalid_argument("Start vertex not found in the graph.");
+
+        // snapshot indices are GetVertex positions, so the start needs no lookup in the snapshot
+        std::shared_ptr<const CsrGraph<TKey>> graph = GetSnapshot();
+        DijkstraEngine<TQueue> engine;
+        const std::vector<int>& distances = engine.Run(*graph, positions[startId]);
+        DynamicArray<int> result(graph->GetVertexCount());
+
+        for (int i = 0; i < graph->GetVertexCount(); i++)
+            result.Set(i, distances[i]);
+
+        return result;
+    }
+
+    // Runs on a CSR snapshot with a flat union-find; MinimumSpanningTreeEngine in minimum_spanning_tree.h returns both
+    // endpoints of every edge and scales to much larger graphs.
+    DynamicArray<Edge> FindMinimumSpanningTreeKruskal() const
+    {
+        return GetSnapshot()->FindMinimumSpanningTreeKruskal();
+    }
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "flat_hash_table.h"
+
+
+
+// Maps vertex keys to dense 32-bit ids, so that adjacency and per-vertex state can live in flat arrays.
+// A key is hashed once when it is interned; afterwards the id indexes everything, and GetKey turns it back
+// into the key for output. Released ids go to a free list and are handed out again before the id range
+// grows, so the ids stay within [0, GetCapacity()) and dense under churn. Every release bumps the generation
+// of the slot, which lets a holder of an (id, generation) pair notice that the vertex behind it has changed.
+template <typename TKey>
+class VertexInterner {
+private:
+
+    FlatHashTable<TKey, uint32_t> ids;
+    std::vector<TKey> keys;
+    std::vector<uint32_t> generations;
+    std::vector<char> alive;
+    std::vector<uint32_t> freeIds;
+
+public:
+
+    static constexpr uint32_t invalidId = std::numeric_limits<uint32_t>::max();
+
+    void Reserve(int count)
+    {
+        if (count <= 0)
+            return;
+
+        ids.Reserve(count);
+        keys.reserve(count);
+        generations.reserve(count);
+        alive.reserve(count);
+    }
+
+    void Clear()
+    {
+        ids = FlatHashTable<TKey, uint32_t>();
+        keys.clear();
+        generations.clear();
+        alive.clear();
+        freeIds.clear();
+    }
+
+    // Returns the id of the key, assigning one (a recycled one if possible) when the key is new. The key is
+    // hashed once for both the lookup and the insert.
+    uint32_t Intern(const TKey& key)
+    {
+        uint32_t id = freeIds.empty() ? (uint32_t)keys.size() : freeIds.back();
+        auto [stored, inserted] = ids.TryEmplace(key, id);
+
+        if (!inserted)
+            return *stored;
+
+        if (freeIds.empty())
+        {
+            keys.push_back(key);
+            generations.push_back(0);
+            alive.push_back(true);
+        }
+        else
+        {
+            freeIds.pop_back();
+            keys[id] = key;
+            alive[id] = true;
+        }
+
+        return id;
+    }
+
+    uint32_t Find(const TKey& key) const
+    {
+        const uint32_t* id = ids.Find(key);
+
+        return id ? *id : invalidId;
+    }
+
+    // Frees the id of the key and returns it, or invalidId for an unknown key.
+    uint32_t Release(const TKey& key)
+    {
+        const uint32_t* stored = ids.Find(key);
+
+        if (!stored)
+            return invalidId;
+
+        uint32_t id = *stored;
+        ids.Remove(key);
+        keys[id] = TKey();
+        alive[id] = false;
+        generations[id]++;
+        freeIds.push_back(id);
+
+        return id;
+    }
+
+    bool IsAlive(uint32_t id) const
+    {
+        return id < alive.size() && alive[id];
+    }
+
+    const TKey& GetKey(uint32_t id) const
+    {
+        return keys[id];
+    }
+
+    // Number of times the id has been released so far.
+    uint32_t GetGeneration(uint32_t id) const
+    {
+        return generations[id];
+    }
+
+    // Keys currently interned.
+    int GetCount() const
+    {
+        return ids.GetCount();
+    }
+
+    // Upper bound of the id range, i.e. the length per-id arrays need.
+    int GetCapacity() const
+    {
+        return (int)keys.size();
+    }
+
+    int GetFreeCount() const
+    {
+        return (int)freeIds.size();
+    }
+};